@@ -9,7 +9,8 @@
 #define AGENT_HPP_
 
 #include <array>
-#include <atomic>
+#include <chrono>
+#include <string>
 
 #include "GameConfig.h"
 #include "Card.h"
@@ -18,18 +19,24 @@
 #include "History.h"
 #include "State.h"
 
+// Seat (player_id) and team are assigned by the table that owns the agent
+// through set_seat(); until then they are -1.
 class Agent
 {
-private:
-	static std::atomic<int> next_id;
-
 protected:
 	int player_id{-1};
 	int team_id{-1};
 	std::string name{""};
+	// prefix of the default name, completed with the seat
+	std::string name_tag{"AG_"};
 	Hand hand;
 
 public:
+	using Clock = std::chrono::steady_clock;
+	// When a decision is due; NO_DEADLINE: no limit.
+	using Deadline = Clock::time_point;
+	static constexpr Deadline NO_DEADLINE = Deadline::max();
+
 	Agent();
 
 	virtual ~Agent(){};
@@ -42,6 +49,10 @@ public:
 
 	virtual Card act(const State &, const History &) = 0;
 
+	// act() under a hard deadline from the table. Agents whose thinking
+	// time varies override it; the others ignore the deadline.
+	virtual Card act(const State &state, const History &hist, Deadline) { return act(state, hist); }
+
 	virtual void trick_result(const State &, const std::array<int, Hokm::N_TEAMS> &){};
 
 	virtual void reset(){};
@@ -60,7 +71,7 @@ public:
 
 	void set_name(std::string);
 
-	static void reset_id() { next_id.store(0); };
+	void set_seat(int seat);
 };
 
 #endif /* AGENT_HPP_ */
@@ -2,26 +2,30 @@
 
 #include <string>
 #include <cstdint>
+#include <stdexcept>
 
 using Suit = int;
 using Rank = int;
 using Cid = int;
 
+// A card is its id `su * N_RANKS + rnk` in a single byte; suit and rank are
+// derived on demand. NONE carries NON_ID and reports NON_SU / NON_RNK.
 class Card
 {
 
 public:
-	Suit su;
-	Rank rnk;
-	Cid id;
+	std::uint8_t id;
 
-	Card();
-	Card(Cid id);
-	Card(Suit su, Rank rnk);
+	constexpr Card() : id(NON_ID) {}
+	constexpr Card(Cid id);
+	constexpr Card(Suit su, Rank rnk);
 	Card(std::string str);
 
 	Card& set(Suit su, Rank rnk);
 
+	constexpr Suit suit() const { return id < N_CARDS ? id / N_RANKS : NON_SU; }
+	constexpr Rank rank() const { return id < N_CARDS ? id % N_RANKS : NON_RNK; }
+
 	// cl > cr ?
 	static int cmp(const Card &cl, const Card &cr, Suit led, Suit trump);
 	int cmp(const Card &rhs, Suit led, Suit trump);
@@ -30,8 +34,8 @@ public:
 	std::string to_unc_str() const;
 	std::string to_color_unc_str() const;
 
-	bool operator==(const Card &oth) const;
-	bool operator!=(const Card &oth) const;
+	constexpr bool operator==(const Card &oth) const { return id == oth.id; }
+	constexpr bool operator!=(const Card &oth) const { return id != oth.id; }
 
 	enum SUIT
 	{
@@ -61,11 +65,11 @@ public:
 
 	static const Card NONE;
 
-	static const int N_CARDS = 52;
-	static const int N_SUITS = 4;
-	static const int N_RANKS = N_CARDS / N_SUITS;
+	static constexpr int N_CARDS = 52;
+	static constexpr int N_SUITS = 4;
+	static constexpr int N_RANKS = N_CARDS / N_SUITS;
 
-	static const Cid NON_ID = N_CARDS + N_RANKS;
+	static constexpr Cid NON_ID = N_CARDS + N_RANKS;
 	//	static const Suit NON_SU = N_SUITS;
 	//	static const Rank NON_RNK = N_RANKS;
 
@@ -73,3 +77,25 @@ public:
 	static const std::string SU_STR[];
 	static const std::string SU_UNC_STR[];
 };
+
+static_assert(sizeof(Card) == 1, "Card must stay a single byte");
+
+inline constexpr Card Card::NONE{};
+
+constexpr Card::Card(Cid id) : id(NON_ID)
+{
+#ifdef DEBUG
+	if ((id >= N_CARDS && id != NON_ID) || id < 0)
+		throw std::invalid_argument("Card::Card(id): Invalid card id.");
+	if (id == NON_ID)
+		throw std::invalid_argument("Card::Card(id): You can't construct NONE card this way!");
+#endif
+	if (id >= 0 && id < N_CARDS)
+		this->id = static_cast<std::uint8_t>(id);
+}
+
+constexpr Card::Card(Suit su, Rank rnk) : id(NON_ID)
+{
+	if (su >= 0 && su < N_SUITS && rnk >= two && rnk <= Ace)
+		this->id = static_cast<std::uint8_t>(su * N_RANKS + rnk);
+}
@@ -1,20 +1,17 @@
 #pragma once
 
 #include <string>
-#include <random>
-
 #include "Card.h"
 #include "Hand.h"
+#include "Rng.h"
 
 class CardStack {
 	Card cards_arr[Card::N_CARDS];
 	int nbr_cards;
 public:
 	std::uint64_t bin64;
-private:
-	std::mt19937 mt_rnd_gen;
 
-public:
+
 	CardStack();
 	CardStack(std::uint64_t bin64);
 	CardStack(const Cid ids_arr[], int nbr_cards);
@@ -26,7 +23,7 @@ public:
 	
 	Card pop();
 
-	CardStack& shuffle();
+	CardStack& shuffle(Rng &rng);
 
 	Card at(int i) const ;
 
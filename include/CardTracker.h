@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Card.h"
+#include "DealSampler.h"
+
+// Who may still hold each unseen card, from one observer's point of view:
+// a bitmask of possible cards per seat (a: next seat, b: previous seat, c:
+// partner) and each seat's card count. A play removes the card, makes the
+// seat void in the led suit if it did not follow and takes one from its
+// count; the counts then propagate with bitwise ops until nothing changes:
+// a seat whose sure cards fill its count holds nothing else, and a seat that
+// may hold only as many cards as it has holds all of them. Every play can be
+// undone.
+class CardTracker
+{
+public:
+	static constexpr int N_SEATS = 3;
+
+	CardTracker() { reset(0, 0); }
+
+	// `unseen` may be anywhere; every seat holds `n_each` cards.
+	void reset(std::uint64_t unseen, int n_each);
+
+	// `seat` played `c` in a trick led with `led` (NON_SU when it led).
+	// Returns false if the seat was not thought to hold the card.
+	bool play(int seat, const Card &c, Suit led);
+	// Takes back the last play still on record.
+	void undo();
+	int nbr_plays() const { return depth; }
+
+	std::uint64_t possible(int seat) const { return now.poss[seat]; }
+	// Cards only `seat` may hold.
+	std::uint64_t sure(int seat) const;
+	int count(int seat) const { return now.count[seat]; }
+
+	// The seven disjoint sets SoundAgent and DealSampler work with.
+	CardConstraints constraints() const;
+
+private:
+	struct Snapshot
+	{
+		std::uint64_t poss[N_SEATS];
+		int count[N_SEATS];
+	};
+	Snapshot now;
+	// states before each play; three seats play at most every unseen card
+	std::array<Snapshot, Card::N_CARDS> before;
+	int depth;
+
+	void propagate();
+};
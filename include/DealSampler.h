@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Card.h"
+#include "ProbHand.h"
+#include "Rng.h"
+
+// What a seat knows about the cards it can't see, in SoundAgent's terms: the
+// seven disjoint sets of cards that only a given group of the other three
+// seats (a, b, c) may hold, and how many cards each of them holds.
+struct CardConstraints
+{
+	std::uint64_t a, b, c, ab, bc, ca, abc;
+	int n_a, n_b, n_c;
+};
+
+// Uniform sampler of the deals of seats a, b and c consistent with a
+// CardConstraints, and exact counts over them. A deal is fixed by how many
+// cards of each shared set go to each of its seats (the split) and then which
+// ones; the constructor counts the deals of every split exactly with
+// binomials, and sample() draws a split by its count and then uniform subsets
+// of the sets' masks. No allocation;
+// the object is about 30 KB, so keep one per move rather than per sample.
+class DealSampler
+{
+public:
+	explicit DealSampler(const CardConstraints &cons);
+
+	// Number of consistent deals; 0 for contradictory constraints.
+	std::uint64_t count() const { return total; }
+	static std::uint64_t count(const CardConstraints &cons);
+
+	// `cons` where seats a, b and c may not hold the cards of s_a, s_b and
+	// s_c: count(exclude(...)) / count(cons) is the probability that none of
+	// them does.
+	static CardConstraints exclude(const CardConstraints &cons, std::uint64_t s_a, std::uint64_t s_b,
+								   std::uint64_t s_c = 0);
+
+	// Exact P(card held by a, b, c) over the consistent deals, one pass over
+	// the splits. All zero if count() is 0.
+	void marginals(ProbHand &pa, ProbHand &pb, ProbHand &pc) const;
+
+	// Fills hands[0..2] (a, b, c). Returns false if count() is 0.
+	bool sample(Rng &rng, std::uint64_t hands[3]) const;
+
+private:
+	// x: ab cards to a, y: bc cards to b, z: ca cards to c; the Habc split
+	// follows from the counts.
+	struct Split
+	{
+		std::uint8_t x, y, z;
+	};
+	static constexpr int MAX_SPLITS = (Card::N_RANKS + 1) * (Card::N_RANKS + 1) * (Card::N_RANKS + 1);
+
+	CardConstraints cons;
+	int need_a, need_b;
+	std::uint64_t total;
+	int nbr_splits;
+	std::uint64_t cum[MAX_SPLITS]; // running deal counts of splits[0..i]
+	Split splits[MAX_SPLITS];
+};
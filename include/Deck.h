@@ -8,18 +8,16 @@
 #ifndef DEBUG_DECK_HPP_
 #define DEBUG_DECK_HPP_
 
-#include <random>
-
 #include "Card.h"
 #include "CardStack.h"
 #include "GameConfig.h"
+#include "Rng.h"
 
 class Deck {
 
 private:
 	bool outside;
 	Card cards[Card::N_CARDS];
-	std::mt19937 mt_rnd_gen;
 
 
 public:
@@ -29,12 +27,12 @@ public:
 
 	CardStack to_cardStack() const;
 
-	void shuffle(int cmplx=3);
-	void shuffle_rnd();
-	void shuffle_overhand(int cmplx=1);
-	void shuffle_riffle(int cmplx=1);
-	void shuffle_rnd_bag();
-	void shuffle_deal(CardStack* stacks, int opening_player, int cmplx=3);
+	void shuffle(Rng &rng, int cmplx=3);
+	void shuffle_rnd(Rng &rng);
+	void shuffle_overhand(Rng &rng, int cmplx=1);
+	void shuffle_riffle(Rng &rng, int cmplx=1);
+	void shuffle_rnd_bag(Rng &rng);
+	void shuffle_deal(Rng &rng, CardStack* stacks, int opening_player, int cmplx=3);
 
 	void deal(CardStack* stacks, int opening_player);
 
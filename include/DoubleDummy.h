@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "GameConfig.h"
+#include "Card.h"
+#include "RoundState.h"
+
+// Perfect-information solver: the tricks each team takes when all four hands
+// are known and both sides play their best. Alpha-beta over RoundState with
+// null-window (MTD) probing, sure-trick cutoffs, move ordering and merging of
+// equivalent ranks (cards of one hand with no live card of another hand
+// between them). Tricks are resolved by Hokm::trick_winner, i.e. Card::cmp /
+// GameRound rules.
+//
+// Leads are tried by kind (sure winners first, then low cards, then leads to
+// partner's winner, leads into a ruff last) and within a kind by how often
+// they cut before; the last lead that cut at a trick goes first.
+// Once a card's result rests on no card of its suit above it, the lower
+// cards of that suit in the same hand are not tried. solve_moves() starts
+// each card's probes at the value of the card before it.
+//
+// The transposition table holds bounds at trick starts and after the first
+// card of a trick. Each search also returns the cards whose rank
+// decided its result: trick winners that beat a card of their own suit and
+// the cards the sure-trick count looked at. An entry keeps, per suit, the
+// owners of the live cards down to the lowest of those only, and the cards
+// below it as suit lengths, so it also serves positions that differ in the
+// small cards.
+//
+// One instance is single-threaded; keep one per thread. Its table survives
+// between solve() calls, which helps on related positions.
+class DoubleDummy
+{
+public:
+	// 2^tt_log2 table entries of 32 bytes, in buckets of WAYS
+	explicit DoubleDummy(int tt_log2 = 20);
+
+	// Tricks each team ends the round with, counting those already taken in
+	// `st`, when all remaining tricks are played out.
+	std::array<int, Hokm::N_TEAMS> solve(const RoundState &st);
+
+	using Clock = std::chrono::steady_clock;
+
+	// Tricks the side to move's team ends the round with after each of its
+	// legal cards: cards[i] -> tricks[i]. Returns the number of legal cards,
+	// or 0 if the search was still running at `stop`.
+	int solve_moves(const RoundState &st, Card cards[], int tricks[], Clock::time_point stop = Clock::time_point::max());
+
+	void clear();
+
+	std::uint64_t nodes() const { return nbr_nodes; }
+
+private:
+	static constexpr int WAYS = 16;
+	static constexpr std::uint32_t HISTORY_MAX = (1u << 19) - 1;
+	// owners of a suit's live cards, 2 bits each, fill the bits below this
+	static constexpr int SEQ_BITS = 2 * Card::N_RANKS;
+
+	// A position up to the ranks of its cards, cards on the table counting as
+	// their seat's; it holds for a whole trick.
+	struct Shape
+	{
+		std::uint64_t lengths; // 4 bits per suit and seat
+		std::uint32_t seq[Card::N_SUITS]; // owners of the live cards from the top, in the top bits
+	};
+
+	struct Entry
+	{
+		std::uint64_t lengths;
+		// the top part of Shape::seq that matters, and above SEQ_BITS how
+		// many cards it covers
+		std::uint32_t seq[Card::N_SUITS];
+		std::uint32_t ctx; // leader, trump and table_key()
+		std::int8_t lo, hi; // bounds on team 0's tricks from this trick on
+		std::int8_t best_su, best_pos; // best card: suit and live cards above it
+	};
+
+	std::vector<Entry> tt;
+	std::uint64_t tt_mask; // of bucket indices
+	std::uint64_t nbr_nodes;
+	// solve_moves() gives up at stop_at; the clock is read every CLOCK_EVERY
+	// nodes
+	static constexpr std::uint64_t CLOCK_EVERY = 1 << 12;
+	Clock::time_point stop_at{Clock::time_point::max()};
+	bool stopped{false};
+	// shape() of the trick in progress, per trick
+	Shape shapes[Hokm::N_TRICKS];
+	// the last lead that cut, per trick
+	Card killer[Hokm::N_TRICKS];
+	// per seat and card, tricks left squared summed over the leads that cut,
+	// up to HISTORY_MAX
+	std::uint32_t history[Hokm::N_PLAYERS][Card::N_CARDS];
+
+	// Team 0's tricks from the current trick on, fail-soft in (alpha, beta);
+	// `rel` gets the cards whose rank the result rests on. Once `stopped`,
+	// it unwinds without storing anything and the result is meaningless.
+	int search(RoundState &st, int alpha, int beta, std::uint64_t &rel);
+	// Exact value of search() by null-window probes, the first at `guess`
+	// (-1: none).
+	int value(RoundState &st, int guess);
+	// Lower bounds on the tricks each team takes from a trick start on, and
+	// the cards each rests on.
+	static void sure_tricks(const RoundState &st, int sure[Hokm::N_TEAMS], std::uint64_t seen[Hokm::N_TEAMS]);
+	// `win` if it took the trick by beating a card of its own suit.
+	static std::uint64_t rank_winner(const Card trick[Hokm::N_PLAYERS], Card win);
+	static Shape shape(const RoundState &st);
+	// The cards on the table, by suit and rank among the live cards.
+	static std::uint32_t table_key(const RoundState &st);
+	// Mask of the top `k` owner slots of Shape::seq.
+	static std::uint32_t top_bits(int k) { return ((1u << 2 * k) - 1) << (SEQ_BITS - 2 * k); }
+	static bool matches(const Entry &e, const Shape &sh, std::uint32_t ctx);
+	// The live cards of `st` that entry `e` pins down.
+	static std::uint64_t region(const RoundState &st, const Entry &e);
+	void store(Entry *bucket, const Shape &sh, std::uint32_t ctx, const RoundState &st, std::uint64_t rel, int alpha,
+			   int beta, int best, Card best_mv, std::uint64_t live);
+	// Representatives of the legal cards of the side to move, best first.
+	int ordered_moves(const RoundState &st, Card out[]) const;
+	// Legal cards of the side to move equivalent to `c`, `c` included.
+	std::uint64_t equivalents(const RoundState &st, Card c) const;
+	// Moves the representative of `c` among mv[0..n) to the front, if `c` is
+	// a card of the side to move.
+	void to_front(const RoundState &st, Card mv[], int n, Card c) const;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "GameConfig.h"
+#include "Card.h"
+#include "DoubleDummy.h"
+#include "RoundState.h"
+#include "ThreadPool.h"
+
+// Solves many double-dummy positions on a thread pool, each worker with its
+// own DoubleDummy and transposition table. Results are exact, so they don't
+// depend on the number of threads or on how tasks land on workers.
+class DoubleDummyBatch
+{
+public:
+	// Tricks each team takes for every trump and leader of one deal:
+	// tricks[trump][leader][team].
+	struct TrickTable
+	{
+		std::array<int, Hokm::N_TEAMS> tricks[Card::N_SUITS][Hokm::N_PLAYERS];
+	};
+
+	// nbr_threads == 0: one per hardware thread; 2^tt_log2 table entries each
+	explicit DoubleDummyBatch(int nbr_threads = 0, int tt_log2 = 20);
+
+	unsigned size() const { return pool.size(); }
+
+	// tricks[i] = DoubleDummy::solve(positions[i])
+	void solve(const RoundState *positions, std::size_t n, std::array<int, Hokm::N_TEAMS> *tricks);
+	std::vector<std::array<int, Hokm::N_TEAMS>> solve(const std::vector<RoundState> &positions);
+
+	// Trick tables of deals given as four disjoint hands of equal length;
+	// shorter hands stand for the last tricks of a round.
+	void solve_tables(const std::array<std::uint64_t, Hokm::N_PLAYERS> *deals, std::size_t n, TrickTable *tables);
+	std::vector<TrickTable> solve_tables(const std::vector<std::array<std::uint64_t, Hokm::N_PLAYERS>> &deals);
+	TrickTable solve_table(const std::array<std::uint64_t, Hokm::N_PLAYERS> &deal);
+
+private:
+	ThreadPool pool;
+	std::vector<std::unique_ptr<DoubleDummy>> solvers;
+};
@@ -1,8 +1,9 @@
 #pragma once
 
-#include <random>
 #include <memory>
 #include <array>
+#include <chrono>
+#include <stdexcept>
 
 #include "GameConfig.h"
 #include "Agent.h"
@@ -11,10 +12,31 @@
 #include "Hand.h"
 #include "Deck.h"
 #include "History.h"
+#include "Rng.h"
+#include "RoundSnapshot.h"
 #include "State.h"
+#include "Trick.h"
+#include "table.h"
+#include "utils.h"
 
 class Agent;
 
+// Typed round events. GameRound::play(obs) calls these members on any type
+// that provides them; NullObserver is the headless default and inlines to
+// nothing, so AI-vs-AI rounds never build a string.
+struct NullObserver
+{
+    void round_start(int /*round_id*/) {}
+    void trick_start(const State &) {}
+    void awaiting_card(int /*pl*/) {}
+    // after `c` is on state.table[pl]
+    void card_played(int /*pl*/, const Card & /*c*/, const State &) {}
+    // before the table is cleared
+    void trick_won(int /*pl*/, const State &, const std::array<int, Hokm::N_TEAMS> & /*scores*/,
+                   bool /*round_finished*/) {}
+    void round_over(int /*winner_team*/, int /*kot*/, const std::array<int, Hokm::N_TEAMS> & /*scores*/) {}
+};
+
 class GameRound
 {
     friend class LearningGame;
@@ -27,7 +49,10 @@ private:
     std::array<Hand, Hokm::N_PLAYERS> hand;
     std::array<Agent *, Hokm::N_PLAYERS> agent;
     std::array<int, Hokm::N_TEAMS> team_scores;
-    std::mt19937 mt_rnd_gen;
+    Rng rng;
+
+    // Emits the /INF, /ALR, /TBL, ... text protocol; used when show_info.
+    struct InfoBroadcaster;
 	
 	public:
     State state;
@@ -39,12 +64,20 @@ private:
     bool show_info = false;
     int turn_sleep_ms = 500;
     int rnd_sleep_ms = 1500;
+    // Hard limit on each agent decision, passed to act() as a deadline; 0
+    // for none.
+    int move_time_ms = 0;
 	std::string name[Hokm::N_PLAYERS];
 
-    GameRound(std::array<Agent *, Hokm::N_PLAYERS>);
+    GameRound(std::array<Agent *, Hokm::N_PLAYERS>, Rng rng = Rng::from_entropy());
 
+    template <class Observer>
+    int trick(Observer &obs);
     int trick();
 
+    template <class Observer>
+    int play(Observer &obs, int round_win_score = Hokm::RND_WIN_SCORE);
+    // Broadcasts to the agents if show_info, otherwise runs headless.
     int play(int round_win_score = Hokm::RND_WIN_SCORE);
 
     void reset();
@@ -55,9 +88,135 @@ private:
 
     void broadcast_info(std::string info_str, int exclude = -1);
 
+    // Engine state of the round in progress. After restore(), play() goes on
+    // from it: from the first unfinished trick, after any cards already on
+    // the table. The agents' own state is left alone; seat them with their
+    // hands before playing on.
+    RoundSnapshot capture() const;
+    void restore(const RoundSnapshot &snap);
+
     // NEW: expose current hand scores for snapshotting on resume
     const std::array<int, Hokm::N_TEAMS>& get_hand_scores() const { return team_scores; }
 
     // NEW: expose a player's current hand string (for convenience)
     const Hand& get_player_hand(int pid) const { return hand[pid]; }
 };
+
+template <class Observer>
+int GameRound::trick(Observer &obs) {
+  // A restored round may stop mid-trick; a full table is a finished trick.
+  int on_table = 0;
+  for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+    on_table += state.table[pl] != Card::NONE;
+  if (on_table == Hokm::N_PLAYERS)
+    on_table = 0;
+  if (on_table == 0) {
+    state.reset();
+    LOG("+++ Trick id " << (int)state.trick_id << " turn " << (int)state.turn
+                        << " trump " << Card::SU_STR[state.trump] << " +++");
+    obs.trick_start(state);
+  }
+
+  for (int ord = on_table; ord < Hokm::N_PLAYERS; ord++) {
+    int pl = (state.turn + ord) % Hokm::N_PLAYERS;
+    state.ord = ord;
+
+    obs.awaiting_card(pl);
+
+    const Agent::Deadline deadline =
+        move_time_ms > 0
+            ? Agent::Clock::now() + std::chrono::milliseconds(move_time_ms)
+            : Agent::NO_DEADLINE;
+    Card c = agent[pl]->act(state, hist, deadline);
+
+    LOG(">>> " + agent[pl]->get_name() + " played " + c.to_string());
+
+#ifdef DEBUG
+    if (!is_legal_move(hand[pl], c, state.led)) {
+      LOG("Game::trick: Card " + c.to_string() + " is not a valid act for " +
+          agent[pl]->get_name() + " while led: " + Card::SU_STR[state.led] +
+          ", hand: " + hand[pl].to_string());
+      throw std::runtime_error("Illegal card played");
+    }
+#endif
+
+    if (ord == 0)
+      state.led = c.suit();
+    state.table[pl] = c;
+    hand[pl].remove(c);
+
+    obs.card_played(pl, c, state);
+  }
+
+  int best_pl = Hokm::trick_winner(state.table, state.led, state.trump);
+
+  for (int pl = 0; pl < Hokm::N_PLAYERS; pl++) {
+    collect.append(state.table[pl]);
+    hist.played_cards[pl].append(state.table[pl]);
+    LOG(agent[pl]->get_name()
+        << " played " << hist.played_cards[pl].at(-1).to_string());
+  }
+
+  LOG("^^^ Trick id " << (int)state.trick_id << " turn " << (int)state.turn
+                      << " led " << Card::SU_STR[state.led] << " trump "
+                      << Card::SU_STR[state.trump] << " ^^^");
+
+  return best_pl;
+}
+
+template <class Observer>
+int GameRound::play(Observer &obs, int round_win_score) {
+  obs.round_start(round_id);
+  kot = 0;
+  // 0 after reset(), the finished tricks after restore()
+  const int first_trick = hist.played_cards[0].get_nbr_cards();
+  for (int trick_id = first_trick; trick_id < Hokm::N_TRICKS; trick_id++) {
+    state.trick_id = trick_id;
+#ifdef DEBUG
+    for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+      LOG(agent[pl]->get_name()
+          << " hand " << agent[pl]->get_hand().to_string());
+    LOG("=== Round " << round_id << ", Trick " << trick_id
+                     << ", Turn: " << (int)state.turn
+                     << ", Trump: " << Card::SU_STR[state.trump]);
+#endif
+
+    int trick_taker = trick(obs);
+
+    int trick_taker_team = trick_taker % Hokm::N_TEAMS;
+    team_scores[trick_taker_team]++;
+    state.turn = trick_taker;
+
+    for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+      agent[pl]->trick_result(state, team_scores);
+
+    bool round_finished = false;
+    for (int team = 0; team < Hokm::N_TEAMS; team++)
+      if (team_scores[team] >= round_win_score) {
+        round_finished = true;
+        winner_team = team;
+        break;
+      }
+
+    obs.trick_won(trick_taker, state, team_scores, round_finished);
+    table_clear(state.table);
+
+    if (round_finished) {
+      int oth_scr = 0;
+      for (int team = 0; team < Hokm::N_TEAMS; team++)
+        if (team != winner_team)
+          oth_scr += team_scores[team];
+      kot = (int)(oth_scr == 0) +
+            (int)((oth_scr == 0) && (winner_team != trump_team));
+      LOG("kot: " << kot << ", oth_scr: " << oth_scr << ", winner_team: "
+                  << winner_team << ", trump_team: " << trump_team);
+      break;
+    }
+  } // trick_id
+
+  for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+    collect.append(hand[pl]);
+
+  obs.round_over(winner_team, kot, team_scores);
+  return winner_team;
+}
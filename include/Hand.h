@@ -4,20 +4,32 @@
 #include <cstdint>
 
 #include "Card.h"
+#include "bits.h"
 
+// A set of cards kept as a single bitboard: card id `su * N_RANKS + rnk` is bit
+// `id`, so every suit occupies its own 13-bit lane and set algebra, lengths
+// and top/bottom queries are a handful of ALU ops.
 class Hand {
 
 public:
 
-	Rank cards[Card::N_SUITS][Card::N_RANKS];
-	int len[Card::N_SUITS];
 	std::uint64_t bin64;
-	int nbr_cards;
 
 	Hand();
 	Hand(const Card *cards, int nbr_cards);
 	Hand(std::uint64_t bin64);
 
+	static constexpr std::uint64_t SUIT_LANE = (1ull << Card::N_RANKS) - 1;
+	static constexpr std::uint64_t ALL_MASK = (1ull << Card::N_CARDS) - 1;
+
+	// NON_SU maps to an empty mask.
+	static std::uint64_t suit_mask(Suit su) { return (SUIT_LANE << su * Card::N_RANKS) & ALL_MASK; }
+	// Cards of suit `su` ranked strictly above `rnk`.
+	static std::uint64_t above_mask(Suit su, Rank rnk) { return suit_mask(su) & (~0ull << (su * Card::N_RANKS + rnk + 1)); }
+
+	int len(Suit su) const { return popcount64(bin64 & suit_mask(su)); }
+	int nbr_cards() const { return popcount64(bin64); }
+
 	Hand& add(const Card &c);
 	Hand& add(const Card *cards, int nbr_cards);
 	Hand& add(const Hand &);
@@ -25,12 +37,10 @@ public:
 	Card pop(Suit su, int ind);
 	Hand pop(Suit su);
 
-	Hand& rm(const Card &c);
 	bool remove(const Card &c);
 	Hand& discard(Suit);
-	
+
 	Hand& rm_top(Suit su, int n);
-	Hand& restore_top(Suit su, int n);
 
 	bool is_in(const Card &c) const;
 
@@ -42,9 +52,9 @@ public:
 
 	Hand& clear();
 
-	Hand cmpl() const;
-	Hand uni(const Hand&) const;
-	Hand inter(const Hand&) const;
+	Hand cmpl() const { return Hand(~bin64 & ALL_MASK); }
+	Hand uni(const Hand &h) const { return Hand(bin64 | h.bin64); }
+	Hand inter(const Hand &h) const { return Hand(bin64 & h.bin64); }
 
 	Hand lead_gt(const Card&, Suit led, Suit trump) const;
 	Hand gt_c_led(const Card &card, Suit led, Suit trump) const;
@@ -53,8 +63,8 @@ public:
 	Hand gt_h_lead(const Hand& h, Suit led, Suit trump) const;
 	Hand gt(const Card&, Suit led, Suit trump) const;
 
-	Card top(Suit su);
-	Card bottom(Suit su);
+	Card top(Suit su) const;
+	Card bottom(Suit su) const;
 	Card min_mil_trl(Suit led, Suit trump, const int* = nullptr) const;
 	Card maxLed_maxTr_min_mil(Suit led, Suit trump) const;
 
@@ -65,3 +75,17 @@ public:
 	static const Hand EMPTY;
 
 };
+
+// Mask of the cards of `hand` that may be played to a trick led with `led`:
+// the led suit if the hand holds any, otherwise every card (also when led is
+// NON_SU).
+inline std::uint64_t legal_moves(const Hand &hand, Suit led)
+{
+	std::uint64_t follow = hand.bin64 & Hand::suit_mask(led);
+	return follow ? follow : hand.bin64;
+}
+
+inline bool is_legal_move(const Hand &hand, const Card &c, Suit led)
+{
+	return c.id < Card::N_CARDS && (legal_moves(hand, led) >> c.id & 1);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "GameConfig.h"
+#include "DealSampler.h"
+#include "Rng.h"
+#include "RoundState.h"
+#include "SoundAgent.h"
+#include "ThreadPool.h"
+#include "TimeManager.h"
+
+// Single-observer information-set MCTS on top of SoundAgent's card
+// inference. Every iteration samples a deal consistent with the sets and
+// counts SoundAgent keeps, walks the tree along the moves legal in that deal
+// (UCB with availability counts), adds one node, plays the rest out with
+// MonteCarloAgent's rollout policy and backs the result up, each node scored
+// for the team that made its move. The tree holds every seat's plays, so on
+// the next turn it is re-rooted on our card and the three plays seen since,
+// and the statistics below carry over. Nodes live in a fixed arena; once it
+// is full the search goes on without growing the tree. The search is
+// anytime: it stops at the deadline, at the move's share of the round's time
+// budget or at the iteration cap, whichever comes first, and plays the most
+// visited card. Trump is called the SoundAgent way.
+//
+// With several threads they all search the one tree: node statistics are
+// atomic, a thread counts its visit on the way down (a virtual loss, until
+// its reward is backed up) so the others spread over other branches, and a
+// child is added by claiming its card in the parent's `expanded` mask and
+// pushing it onto the child list with a compare-and-swap, with no lock.
+class ISMCTSAgent : public SoundAgent
+{
+public:
+	// time_budget_ms: mean wall time per move, spread over the round by a
+	// TimeManager, 0 for none; max_iterations: per move, 0 for no cap (one of
+	// the two must be set); nbr_threads == 0: one per hardware thread;
+	// max_nodes: arena size.
+	ISMCTSAgent(int time_budget_ms = 200, int max_iterations = 0, int nbr_threads = 1, int max_nodes = 1 << 17,
+				Rng rng = Rng::from_entropy());
+
+	// Per-seat strength/speed trade-off; takes effect from the next move.
+	void set_budget(int time_budget_ms, int max_iterations);
+
+	void init_round(const Hand &hand) override;
+
+	Card act(const State &, const History &) override;
+	Card act(const State &, const History &, Deadline) override;
+
+	void trick_result(const State &, const std::array<int, Hokm::N_TEAMS> &scores) override;
+
+	// Iterations run for the last move, and root visits carried over into it
+	// from the previous one.
+	int last_iterations() const { return nbr_iterations; }
+	int last_reused() const { return nbr_reused; }
+	// Visits of the node the plays path[0..len) lead to from the root, 0 if
+	// the tree does not hold it.
+	int tree_visits(const Card path[], int len) const;
+
+	// Exploration constant of the UCB rule.
+	static constexpr double UCB_C = 0.7;
+
+	// A worker reads the clock every CLOCK_EVERY iterations, and after every
+	// iteration once the deadline is less than NEAR_DEADLINE away.
+	static constexpr int CLOCK_EVERY = 16;
+	static constexpr std::chrono::microseconds NEAR_DEADLINE{1000};
+
+private:
+	static constexpr int NIL = -1;
+
+	// Rewards are counted in steps of 1 / REWARD_SCALE, which makes them
+	// integers: RND_WIN_SCORE tricks or more are worth one more unit.
+	static constexpr int REWARD_SCALE = Hokm::N_TRICKS + 1;
+
+	struct Node
+	{
+		Card card;						   // the move into this node
+		std::int8_t pl;					   // seat that made it
+		std::atomic<int> first_child{NIL}; // arena indices, NIL for none
+		int next_sibling{NIL};			   // set before the node is linked
+		std::atomic<std::uint64_t> expanded{0}; // cards claimed for a child
+		std::atomic<std::uint32_t> visits{0};
+		std::atomic<std::uint32_t> avail{0};  // iterations in which the move was legal
+		std::atomic<std::uint64_t> reward{0}; // sum, for the team of `pl`
+	};
+
+	TimeManager timer;
+	int max_iterations;
+	int nbr_iterations{0};
+	int nbr_reused{0};
+	std::array<int, Hokm::N_TEAMS> team_scores{};
+	ThreadPool pool;
+	std::vector<Rng> rngs;
+
+	// `nodes` holds the tree, rooted at index 0; `spare` is where re-rooting
+	// copies the kept subtree. Both are sized once.
+	std::vector<Node> nodes, spare;
+	std::atomic<int> nbr_nodes{0};
+	// Our last card, NONE before our first move of the round.
+	Card last_card;
+
+	// Takes a fresh node from the arena, NIL if it is full.
+	int new_node(Card card, int pl);
+	// The node the plays path[0..len) lead to from the root, NIL if none.
+	int find(const Card path[], int len) const;
+	void clear_tree();
+	// Re-roots on the plays since our last move; clears the tree if one of
+	// them was never expanded.
+	void advance(const State &, const History &);
+	void iterate(RoundState &st, Rng &rng);
+};
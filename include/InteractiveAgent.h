@@ -19,6 +19,7 @@ public:
 
 	void init_game() override;
 	void init_round(const Hand &hand) override;
+	using Agent::act;
 	Card act(const State&, const History&) override;
 	Suit call_trump(const CardStack&) override;
 
@@ -13,8 +13,12 @@
 #include "GameConfig.h"
 #include "GameRound.h"
 
+class MultiClientServer;
+
 class InteractiveGame {
 private:
+    // remote players of this table
+    std::unique_ptr<MultiClientServer> server;
     std::array<Agent*, Hokm::N_PLAYERS>agent;
     std::unique_ptr<GameRound> round;
     std::array<int, Hokm::N_TEAMS>team_scores = {0};
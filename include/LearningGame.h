@@ -8,28 +8,49 @@
 #ifndef LEARNINGGAME_H_
 #define LEARNINGGAME_H_
 
+#include <array>
+#include <vector>
+
 #include "GameConfig.h"
 #include "Agent.h"
 #include "GameRound.h"
+#include "Rng.h"
 
 class LearningGame {
-	std::unique_ptr<GameRound> round;
-	std::array<Agent *, Hokm::N_PLAYERS> agent;
+	// SoundAgent probabilities of each team for one cell of a sweep;
+	// untuned teams keep the SoundAgent defaults.
+	struct Matchup
+	{
+		bool tuned[Hokm::N_TEAMS];
+		double floor[Hokm::N_TEAMS];
+		double trump_cap[Hokm::N_TEAMS];
+	};
+
+	Rng rng;
+	int nbr_threads;
 	int nbr_probs;
 	int nbr_stats;
 	double *probs;
 	double *stats;
 
-	void tweak_floor_trump_probs(int nbr_episodes);
-	void tweak_trump_prob_cap(int nbr_episodes);
-	void tweak_floor_prob(int nbr_episodes);
-	void tweak_floor_prob_vs_rnd(int nbr_episodes);
+	// Rounds won by each team over nbr_episodes games of every matchup.
+	// Episodes run on a thread pool; the result depends only on the seed.
+	std::vector<std::array<int, Hokm::N_TEAMS>> play_matchups(const std::vector<Matchup> &matchups, int nbr_episodes);
+
 public:
-	LearningGame(int nbr_probs, double min_prob = 0, double max_prob = 1);
+	// nbr_threads == 0: one per hardware thread
+	LearningGame(int nbr_probs, double min_prob = 0, double max_prob = 1, Rng rng = Rng::from_entropy(),
+				 int nbr_threads = 0);
 	~LearningGame();
 
 	void play(int nbr_episodes);
 
+	// The sweeps play() picks from; each leaves its win counts in the stats.
+	void tweak_floor_trump_probs(int nbr_episodes);
+	void tweak_trump_prob_cap(int nbr_episodes);
+	void tweak_floor_prob(int nbr_episodes);
+	void tweak_floor_prob_vs_rnd(int nbr_episodes);
+
 	void cp_probs(double *probs_cp);
 	void cp_stats(double *stats_cp);
 	int get_nbr_stats();
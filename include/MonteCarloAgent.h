@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "GameConfig.h"
+#include "DoubleDummy.h"
+#include "Rng.h"
+#include "RoundState.h"
+#include "SoundAgent.h"
+#include "ThreadPool.h"
+#include "TimeManager.h"
+
+// Determinized Monte Carlo play on top of SoundAgent's card inference: deals
+// consistent with the sets and counts SoundAgent keeps are sampled, every
+// legal card is scored in each of them, by a double-dummy solve once few
+// tricks are left and by heuristic rollouts before that, and the card with
+// the best mean wins. Scores count round wins first, then tricks. Trump is
+// called the SoundAgent way.
+class MonteCarloAgent : public SoundAgent
+{
+public:
+	// time_budget_ms: mean wall time per move, spread over the round by a
+	// TimeManager, 0 for none; max_samples: deals per move, 0 for no cap (one
+	// of the two must be set); nbr_threads == 0: one per hardware thread;
+	// dd_tricks: double-dummy scoring from that many tricks left.
+	MonteCarloAgent(int time_budget_ms = 200, int max_samples = 0, int nbr_threads = 1, int dd_tricks = 7,
+					Rng rng = Rng::from_entropy());
+
+	void init_round(const Hand &hand) override;
+
+	Card act(const State &, const History &) override;
+	// Stops sampling at the deadline, or earlier if the round's time budget
+	// says so; a double-dummy solve still running then is given up.
+	Card act(const State &, const History &, Deadline) override;
+
+	void trick_result(const State &, const std::array<int, Hokm::N_TEAMS> &scores) override;
+
+	// Deals scored for the last move.
+	int last_samples() const { return nbr_samples; }
+
+	// Plays `st` out with a cheap greedy policy until the round is decided.
+	static void rollout(RoundState &st, Rng &rng);
+
+private:
+	TimeManager timer;
+	int max_samples;
+	int dd_tricks;
+	int nbr_samples{0};
+	std::array<int, Hokm::N_TEAMS> team_scores{};
+	ThreadPool pool;
+	std::vector<Rng> rngs;
+	std::vector<std::unique_ptr<DoubleDummy>> solvers;
+};
@@ -17,9 +17,15 @@
 #include "GameConfig.h"
 #include "ThreadSafeQueue.h"
 
+// Accepts and tracks the remote players of one table; owned by the game
+// that hosts them.
 class MultiClientServer {
 public:
-    static MultiClientServer& instance();
+    MultiClientServer() = default;
+    ~MultiClientServer();
+
+    MultiClientServer(const MultiClientServer&) = delete;
+    MultiClientServer& operator=(const MultiClientServer&) = delete;
 
     // Starts the server if not already started
     void ensure_started(uint16_t port = 23345);
@@ -58,12 +64,6 @@ public:
     void remove_resume_handler(int id);
 
 private:
-    MultiClientServer() = default;
-    ~MultiClientServer();
-
-    MultiClientServer(const MultiClientServer&) = delete;
-    MultiClientServer& operator=(const MultiClientServer&) = delete;
-
     struct Session {
         int sock{-1};
         int player_id{-1};
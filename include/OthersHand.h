@@ -43,26 +43,22 @@ static std::pair<Card, double> maxProb(const Hand& hand, const OthersHand &othsH
     double max_prb = 0;
     Card max_c;
     double prb;
-    for (Suit s = 0; s < Card::N_SUITS; s++)
+    for (Cid id : BitIter(hand.bin64))
     {
-        for (int i = 0; i < hand.len[s]; i++)
+        prb = 0;
+        c = Card(id);
+        if (certOpHand.gt_c_led(c, led, trump).nbr_cards() == 0)
         {
-            prb = 0;
-            Rank r = hand.cards[s][i];
-            c.set(s, r);
-            if (certOpHand.gt_c_led(c, led, trump).nbr_cards == 0)
+            int k = pssbleOpHand.gt_c_led(c, led, trump).nbr_cards(); // not exactly correct; s may all be in comp
+            prb = chs_prob(pssbleOpHand.nbr_cards(), k, nbrCompEx);
+            if (prb > max_prb)
             {
-                int k = pssbleOpHand.gt_c_led(c, led, trump).nbr_cards; // not exactly correct; s may all be in comp
-                prb = chs_prob(pssbleOpHand.nbr_cards, k, nbrCompEx);
-                if (prb > max_prb)
-                {
-                    max_prb = prb;
-                    max_c = c;
-                }
+                max_prb = prb;
+                max_c = c;
             }
-            LOG("maxProb " + c.to_string() + " " << prb);
-            // this->prob[s][i] = prb;
         }
+        LOG("maxProb " + c.to_string() + " " << prb);
+        // this->prob[s][i] = prb;
     }
     return std::make_pair(max_c, max_prb);
 }
@@ -5,11 +5,16 @@
 // Forward-declare the shared server
 class MultiClientServer;
 
+// Talks to its player through the table's server; connects in init_game(),
+// once seated.
 class RemoteInterAgent : public InteractiveAgent {
+    MultiClientServer &server;
+    bool reserved = false;
 public:
-    RemoteInterAgent(bool show_hand = true);
+    RemoteInterAgent(MultiClientServer &server, bool show_hand = true);
     ~RemoteInterAgent();
 
+    void init_game() override;
     void output(const std::string&) override;
     std::string input(const std::string& prompt) override;
     void fin_game() override;
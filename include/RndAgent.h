@@ -10,13 +10,14 @@
 
 #include "GameConfig.h"
 #include "Agent.h"
-#include <random>
+#include "Rng.h"
 
 class RndAgent : public Agent {
 private:
-	std::mt19937 mt_rnd_gen;
+	Rng rng;
 public:
-	RndAgent();
+	RndAgent(Rng rng = Rng::from_entropy());
+	using Agent::act;
 	Card act(const State&, const History&) override;
 	Suit call_trump(const CardStack&) override;
 };
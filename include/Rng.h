@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// xoshiro256** stream seeded through splitmix64. 32 bytes of state, so it is
+// cheap to copy, pass by reference or keep one per worker. Satisfies
+// UniformRandomBitGenerator for the <random> distributions; below() and
+// uniform() are the fast paths used by the game code.
+class Rng
+{
+	std::uint64_t s[4];
+
+	static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+	using result_type = std::uint64_t;
+
+	static std::uint64_t splitmix64(std::uint64_t &x)
+	{
+		std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	// Stream `stream` of master seed `seed`; distinct (seed, stream) pairs give
+	// unrelated sequences.
+	explicit Rng(std::uint64_t seed = 0, std::uint64_t stream = 0)
+	{
+		std::uint64_t st = stream;
+		std::uint64_t x = seed ^ splitmix64(st);
+		for (auto &w : s)
+			w = splitmix64(x);
+	}
+
+	static Rng from_entropy()
+	{
+		std::random_device rd;
+		return Rng(static_cast<std::uint64_t>(rd()) << 32 | rd());
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return ~0ull; }
+
+	result_type operator()()
+	{
+		const std::uint64_t out = rotl(s[1] * 5, 7) * 9;
+		const std::uint64_t t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 45);
+		return out;
+	}
+
+	// Uniform in [0, n) for n > 0, by multiply-shift (bias < n / 2^64).
+	int below(int n) { return static_cast<int>((unsigned __int128)(*this)() * static_cast<unsigned>(n) >> 64); }
+
+	// Exactly uniform in [0, n) for n > 0 (multiply-shift with rejection).
+	std::uint64_t below64(std::uint64_t n)
+	{
+		unsigned __int128 m = (unsigned __int128)(*this)() * n;
+		if (static_cast<std::uint64_t>(m) < n)
+		{
+			const std::uint64_t floor = (0 - n) % n;
+			while (static_cast<std::uint64_t>(m) < floor)
+				m = (unsigned __int128)(*this)() * n;
+		}
+		return static_cast<std::uint64_t>(m >> 64);
+	}
+
+	// Uniform in [0, 1)
+	double uniform() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+	// Child stream; advances this one.
+	Rng fork()
+	{
+		std::uint64_t seed = (*this)();
+		return Rng(seed, (*this)());
+	}
+};
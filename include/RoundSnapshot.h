@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "GameConfig.h"
+#include "Card.h"
+
+// Plain copy of the engine side of a round in progress: what GameRound needs
+// to resume it, without its Deck / CardStack / History buffers. Agents keep
+// their own beliefs and are not part of it.
+struct RoundSnapshot
+{
+	std::uint64_t hand[Hokm::N_PLAYERS];		 // cards still held by each seat
+	Card plays[Hokm::N_TRICKS][Hokm::N_PLAYERS]; // card of each seat in each finished trick
+	Card table[Hokm::N_PLAYERS];				 // current trick, NONE for seats yet to play
+	std::int8_t trump;
+	std::int8_t led;
+	std::uint8_t turn; // leader of the current trick
+	std::uint8_t ord;
+	std::uint8_t trick_id;
+	std::uint8_t nbr_tricks; // finished tricks, rows of `plays` in use
+	std::int8_t team_scores[Hokm::N_TEAMS];
+	std::int8_t opening_player;
+	std::int8_t trump_team;
+	std::int8_t winner_team;
+	std::int8_t kot;
+	std::int32_t round_id;
+};
+
+static_assert(std::is_trivially_copyable<RoundSnapshot>::value, "RoundSnapshot must stay POD");
+static_assert(sizeof(RoundSnapshot) <= 128, "RoundSnapshot should fit in two cache lines");
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "GameConfig.h"
+#include "Card.h"
+#include "Hand.h"
+#include "RoundSnapshot.h"
+#include "Trick.h"
+#include "Zobrist.h"
+#include "bits.h"
+
+// Lightweight round position for search: hands as masks, the current trick
+// and a move stack, with play()/undo() updating everything in place,
+// Zobrist keys included. Tricks are resolved by Hokm::trick_winner, as in
+// GameRound.
+class RoundState
+{
+public:
+	struct Move
+	{
+		Card card;
+		std::int8_t pl;
+		std::int8_t winner; // seat that took the trick this card completed, or -1
+	};
+
+	std::uint64_t hand[Hokm::N_PLAYERS];
+	Card table[Hokm::N_PLAYERS];
+	Suit trump;
+	Suit led;
+	int leader;
+	int ord; // cards on the table
+	int trick_id;
+	int team_scores[Hokm::N_TEAMS];
+	int nbr_moves;
+	Move moves[Card::N_CARDS];
+
+	// Zobrist keys (Hokm::ZOBRIST): the position, each seat's hand part of
+	// it, and the plays made so far in order.
+	std::uint64_t key;
+	std::uint64_t hand_key[Hokm::N_PLAYERS];
+	std::uint64_t played_key;
+
+	RoundState(const std::uint64_t hands[Hokm::N_PLAYERS], Suit trump, int leader);
+	// The partial trick of the snapshot is pushed as moves, so undo() can go
+	// back to its start but not further.
+	explicit RoundState(const RoundSnapshot &snap);
+
+	int turn() const { return (leader + ord) % Hokm::N_PLAYERS; }
+
+	std::uint64_t legal() const { return legal_moves(Hand(hand[turn()]), led); }
+
+	// Key of what `seat` knows: its own hand, the plays so far and the public
+	// part of the position.
+	std::uint64_t infoset_key(int seat) const
+	{
+		return key ^ hand_key[0] ^ hand_key[1] ^ hand_key[2] ^ hand_key[3] ^ hand_key[seat] ^ played_key;
+	}
+
+	// Position key recomputed from scratch; equals `key`.
+	std::uint64_t compute_key() const;
+
+	bool done() const { return trick_id == Hokm::N_TRICKS; }
+	// A team reached round_win_score tricks.
+	bool decided(int round_win_score = Hokm::RND_WIN_SCORE) const
+	{
+		return team_scores[0] >= round_win_score || team_scores[1] >= round_win_score;
+	}
+
+	// Plays `c` for the side to move. Returns the seat taking the trick if `c`
+	// completes it, -1 otherwise.
+	int play(Card c)
+	{
+		const auto &z = Hokm::ZOBRIST;
+		const int pl = turn();
+#ifdef DEBUG
+		if (!(legal() >> c.id & 1))
+			throw std::invalid_argument("RoundState::play: illegal card " + c.to_string());
+#endif
+		hand[pl] ^= 1ull << c.id;
+		hand_key[pl] ^= z.hand[pl][c.id];
+		played_key ^= z.played[trick_id * Hokm::N_PLAYERS + ord][pl][c.id];
+		key ^= z.hand[pl][c.id] ^ z.table[pl][c.id] ^ z.turn[pl];
+		table[pl] = c;
+		if (ord++ == 0)
+		{
+			led = c.suit();
+			key ^= z.led[Card::NON_SU] ^ z.led[led];
+		}
+		Move &m = moves[nbr_moves++];
+		m.card = c;
+		m.pl = static_cast<std::int8_t>(pl);
+		m.winner = -1;
+		if (ord < Hokm::N_PLAYERS)
+		{
+			key ^= z.turn[turn()];
+			return -1;
+		}
+
+		const int w = Hokm::trick_winner(table, led, trump);
+		const int team = w % Hokm::N_TEAMS;
+		m.winner = static_cast<std::int8_t>(w);
+		key ^= z.score[team][team_scores[team]] ^ z.score[team][team_scores[team] + 1];
+		team_scores[team]++;
+		trick_id++;
+		leader = w;
+		ord = 0;
+		key ^= z.led[led] ^ z.led[Card::NON_SU] ^ z.turn[w];
+		led = Card::NON_SU;
+		for (int p = 0; p < Hokm::N_PLAYERS; p++)
+		{
+			key ^= z.table[p][table[p].id];
+			table[p] = Card::NONE;
+		}
+		return w;
+	}
+
+	// Takes back the last play.
+	void undo()
+	{
+#ifdef DEBUG
+		if (nbr_moves == 0)
+			throw std::invalid_argument("RoundState::undo: no move to take back");
+#endif
+		const auto &z = Hokm::ZOBRIST;
+		const Move &m = moves[--nbr_moves];
+		key ^= z.turn[turn()];
+		if (m.winner >= 0)
+		{
+			// reopen the finished trick from the three plays before this one
+			const int team = m.winner % Hokm::N_TEAMS;
+			team_scores[team]--;
+			key ^= z.score[team][team_scores[team]] ^ z.score[team][team_scores[team] + 1];
+			trick_id--;
+			const Move *first = &m - (Hokm::N_PLAYERS - 1);
+			for (int k = 0; k < Hokm::N_PLAYERS; k++)
+			{
+				table[first[k].pl] = first[k].card;
+				key ^= z.table[first[k].pl][first[k].card.id];
+			}
+			leader = first->pl;
+			led = first->card.suit();
+			key ^= z.led[Card::NON_SU] ^ z.led[led];
+			ord = Hokm::N_PLAYERS;
+		}
+		hand[m.pl] |= 1ull << m.card.id;
+		hand_key[m.pl] ^= z.hand[m.pl][m.card.id];
+		key ^= z.hand[m.pl][m.card.id] ^ z.table[m.pl][m.card.id] ^ z.turn[m.pl];
+		table[m.pl] = Card::NONE;
+		if (--ord == 0)
+		{
+			key ^= z.led[led] ^ z.led[Card::NON_SU];
+			led = Card::NON_SU;
+		}
+		played_key ^= z.played[trick_id * Hokm::N_PLAYERS + ord][m.pl][m.card.id];
+	}
+
+	std::string to_string() const;
+};
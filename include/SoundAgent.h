@@ -1,23 +1,29 @@
 #pragma once
 
-#include <random>
+#include <array>
 #include <utility>
 
 #include "GameConfig.h"
 #include "Agent.h"
 #include "ProbHand.h"
+#include "DealSampler.h"
+#include "CardTracker.h"
+#include "RoundState.h"
 
 class SoundAgent: public Agent {
-private:
-	static int s_id;
-
-	std::mt19937 mt_rnd_gen;
-
+protected:
+	// Where the unseen cards may be, kept play by play.
+	CardTracker tracker;
+	// The tracker's view as of the last observe(): unseen cards by the seats
+	// that may hold them (a: next seat, c: partner, b: previous seat) and
+	// each seat's card count; disjoint sets.
 	Hand Ha, Hb, Hc, Hab, Hbc, Hca, Habc;
 	int Nu_a, Nu_b, Nu_c;
 	int Ncards_a, Ncards_b, Ncards_c;
 
-	// ProbHand Pa, Pb, Pc;
+	// The number of deals consistent with the sets and counts, refreshed by
+	// observe(); act() works from exact counts over them.
+	std::uint64_t nbr_worlds;
 
 	double prob_floor, trump_prob_cap, prob_ceiling;
 
@@ -25,14 +31,38 @@ private:
 	Suit last_led;
 
 	void update_oth_hands(int pl_id, const Card& pl_c, Suit led);
+	// Copies the tracker's sets.
 	void updateHandsNcards();
 
-	// void updateProbs();
+	// Folds the cards played since our last turn into the sets and counts.
+	void observe(const State&, const History&);
+	// Our own card leaves the hand.
+	void record_play(const Card&);
+
+	CardConstraints constraints() const;
+	void updateProbs();
+
+	// Exact chances over the consistent deals that a, playing next, beats
+	// m_c in the current trick, and that a or b beats our lead m_c.
+	double prob_a_beats(const Card &m_c, Suit led, Suit trump) const;
+	double prob_ab_beat_lead(const Card &m_c, Suit trump) const;
+	// The same for every card of `cands` at once, as the chance that the
+	// card holds the trick (1 minus the above) into `out`.
+	void probs_a_fails(std::uint64_t cands, Suit led, Suit trump, ProbHand &out) const;
+	void probs_ab_fail_lead(std::uint64_t cands, Suit trump, ProbHand &out) const;
+
+	// The current position in a deal where a, b, c hold oth[0..2] (a sample
+	// of the sets and counts) and the teams have `scores`; the cards on the
+	// table are replayed, so the trick can be undone to its start.
+	RoundState determinize(const State &, const std::uint64_t oth[3],
+						   const std::array<int, Hokm::N_TEAMS> &scores) const;
 
 
 public:
 
-	SoundAgent(double prob_floor = 0.52, double trump_prob_cap = 1, double prob_ceiling = 1);
+	static constexpr double DEF_PROB_FLOOR = 0.52;
+
+	SoundAgent(double prob_floor = DEF_PROB_FLOOR, double trump_prob_cap = 1, double prob_ceiling = 1);
 	
 	void set_probs(double prob_floor, double trump_prob_cap = 1, double prob_ceiling = 1);
 
@@ -40,6 +70,7 @@ public:
 
 	void init_round(const Hand& hand) override;
 
+	using Agent::act;
 	Card act(const State&, const History&) override;
 
 	void reset() override;
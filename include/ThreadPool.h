@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that run one job at a time. The calling thread
+// takes part as worker 0, so a pool of size 1 spawns no thread at all.
+// Jobs must not call back into the same pool.
+class ThreadPool {
+public:
+    // n == 0: one worker per hardware thread
+    explicit ThreadPool(unsigned n = 0) {
+        if (n == 0)
+            n = std::max(1u, std::thread::hardware_concurrency());
+        nbr_workers_ = n;
+        for (unsigned w = 1; w < n; w++)
+            threads_.emplace_back(&ThreadPool::worker_loop, this, w);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto &t : threads_)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    unsigned size() const { return nbr_workers_; }
+
+    // Runs job(worker) once on every worker and waits for all of them.
+    void run(const std::function<void(unsigned)> &job) {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            job_ = &job;
+            busy_ = nbr_workers_ - 1;
+            generation_++;
+        }
+        cv_.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> lk(m_);
+        done_cv_.wait(lk, [&] { return busy_ == 0; });
+        job_ = nullptr;
+    }
+
+    // Calls fn(task, worker) for every task in [0, nbr_tasks), handing tasks
+    // out on demand. The first exception thrown by a task stops the hand-out
+    // and is rethrown here.
+    template <class Fn>
+    void parallel_for(std::size_t nbr_tasks, Fn &&fn) {
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr err;
+        std::mutex err_m;
+        run([&](unsigned w) {
+            for (std::size_t t; (t = next.fetch_add(1)) < nbr_tasks;) {
+                try {
+                    fn(t, w);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lk(err_m);
+                    if (!err)
+                        err = std::current_exception();
+                    next.store(nbr_tasks);
+                }
+            }
+        });
+        if (err)
+            std::rethrow_exception(err);
+    }
+
+private:
+    unsigned nbr_workers_;
+    std::vector<std::thread> threads_;
+    std::mutex m_;
+    std::condition_variable cv_, done_cv_;
+    const std::function<void(unsigned)> *job_ = nullptr;
+    std::uint64_t generation_ = 0;
+    unsigned busy_ = 0;
+    bool stop_ = false;
+
+    void worker_loop(unsigned w) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(unsigned)> *job;
+            {
+                std::unique_lock<std::mutex> lk(m_);
+                cv_.wait(lk, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+                job = job_;
+            }
+            (*job)(w);
+            {
+                std::lock_guard<std::mutex> lk(m_);
+                if (--busy_ == 0)
+                    done_cv_.notify_all();
+            }
+        }
+    }
+};
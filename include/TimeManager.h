@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+
+// Splits a seat's thinking time for a round over its decisions. Trick t
+// weighs N_TRICKS - t, so early tricks, which branch the most and shape the
+// rest of the round, get the most; a forced move gets nothing. Time a
+// decision leaves unused goes to the later ones. A budget of 0 sets no
+// limit of its own.
+class TimeManager
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit TimeManager(double round_budget_ms = 0) : round_budget_ms(round_budget_ms), left_ms(round_budget_ms) {}
+
+	void set_budget(double round_budget_ms);
+	double budget_ms() const { return round_budget_ms; }
+	double remaining_ms() const { return left_ms; }
+
+	// The whole budget is back.
+	void start_round() { left_ms = round_budget_ms; }
+
+	// Share of what is left for a decision at trick `trick_id` among
+	// `nbr_legal` cards.
+	double allot_ms(int trick_id, int nbr_legal) const;
+
+	// When that decision should be made, starting now; never after `hard`,
+	// which is all there is without a budget.
+	Clock::time_point deadline(int trick_id, int nbr_legal, Clock::time_point hard = Clock::time_point::max()) const;
+
+	// Charges the time a decision took.
+	void spend(double ms);
+
+private:
+	double round_budget_ms;
+	double left_ms;
+};
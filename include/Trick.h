@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "GameConfig.h"
+#include "Card.h"
+
+namespace Hokm {
+
+	// Rank keys of every card for each (led, trump) pair: trump cards get
+	// 32 + rank, led-suit cards 16 + rank and the rest their bare rank, so a
+	// full trick is won by the seat holding the largest key. The index
+	// N_SUITS stands for NON_SU.
+	struct TrickKeyTable
+	{
+		std::uint8_t key[Card::N_SUITS + 1][Card::N_SUITS + 1][Card::N_CARDS];
+
+		constexpr TrickKeyTable() : key{}
+		{
+			for (int led = 0; led <= Card::N_SUITS; led++)
+				for (int trump = 0; trump <= Card::N_SUITS; trump++)
+					for (int id = 0; id < Card::N_CARDS; id++)
+					{
+						int su = id / Card::N_RANKS;
+						key[led][trump][id] = static_cast<std::uint8_t>(
+							id % Card::N_RANKS + 16 * (su == led) + 32 * (su == trump));
+					}
+		}
+	};
+
+	inline constexpr TrickKeyTable TRICK_KEYS{};
+
+	// Winning seat of a full trick given the card id each seat played.
+	inline int trick_winner(const Cid ids[N_PLAYERS], Suit led, Suit trump)
+	{
+		assert(led >= 0 && led <= Card::N_SUITS && trump >= 0 && trump <= Card::N_SUITS);
+		const std::uint8_t *k = TRICK_KEYS.key[led][trump];
+		// seat in the low bits; keys of a full trick never tie at the top
+		int k0 = k[ids[0]] << 2 | 0;
+		int k1 = k[ids[1]] << 2 | 1;
+		int k2 = k[ids[2]] << 2 | 2;
+		int k3 = k[ids[3]] << 2 | 3;
+		return std::max(std::max(k0, k1), std::max(k2, k3)) & 3;
+	}
+
+	inline int trick_winner(const Card table[N_PLAYERS], Suit led, Suit trump)
+	{
+		const Cid ids[N_PLAYERS] = {table[0].id, table[1].id, table[2].id, table[3].id};
+		return trick_winner(ids, led, trump);
+	}
+
+	// Resolves n full tricks: winners[i] = trick_winner(tables[i], led[i], trump[i]).
+	void trick_winners(const Cid (*tables)[N_PLAYERS], const Suit *led, const Suit *trump,
+					   int *winners, std::size_t n);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+#include "GameConfig.h"
+#include "Card.h"
+
+namespace Hokm {
+
+	// Random 64-bit keys for hashing round positions and information sets:
+	// a position key XORs the keys of every (seat, card) held, every card on
+	// the table, the side to move, trump, led suit and both trick scores. An
+	// information set swaps the other seats' hands for the plays seen so far,
+	// each keyed by its place in the round, seat and card, so the order of the
+	// plays and their grouping into tricks count. Index N_SUITS of trump/led
+	// stands for NON_SU.
+	struct ZobristKeys
+	{
+		std::uint64_t hand[N_PLAYERS][Card::N_CARDS];
+		std::uint64_t table[N_PLAYERS][Card::N_CARDS];
+		std::uint64_t played[Card::N_CARDS][N_PLAYERS][Card::N_CARDS]; // [trick * N_PLAYERS + ord][seat][card]
+		std::uint64_t turn[N_PLAYERS];
+		std::uint64_t trump[Card::N_SUITS + 1];
+		std::uint64_t led[Card::N_SUITS + 1];
+		std::uint64_t score[N_TEAMS][N_TRICKS + 1];
+
+		constexpr ZobristKeys() : hand{}, table{}, played{}, turn{}, trump{}, led{}, score{}
+		{
+			// splitmix64, fixed seed: keys are the same in every build
+			std::uint64_t x = 0x486f6b6d5a6f6272ull;
+			auto next = [&x]()
+			{
+				std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+				return z ^ (z >> 31);
+			};
+			for (int pl = 0; pl < N_PLAYERS; pl++)
+				for (int id = 0; id < Card::N_CARDS; id++)
+				{
+					hand[pl][id] = next();
+					table[pl][id] = next();
+				}
+			for (auto &move : played)
+				for (auto &seat : move)
+					for (auto &k : seat)
+						k = next();
+			for (auto &k : turn)
+				k = next();
+			for (auto &k : trump)
+				k = next();
+			for (auto &k : led)
+				k = next();
+			for (auto &team : score)
+				for (auto &k : team)
+					k = next();
+		}
+	};
+
+	inline constexpr ZobristKeys ZOBRIST{};
+}
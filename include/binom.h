@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Card.h"
+
+// Binomial coefficients C(n, k) for 0 <= k <= n <= 52, exact in 64 bits
+// (the largest, C(52, 26), is below 2^49). Built at compile time by Pascal's
+// rule.
+struct BinomTable
+{
+	std::uint64_t c[Card::N_CARDS + 1][Card::N_CARDS + 1];
+
+	constexpr BinomTable() : c{}
+	{
+		for (int n = 0; n <= Card::N_CARDS; n++)
+		{
+			c[n][0] = 1;
+			for (int k = 1; k <= n; k++)
+				c[n][k] = c[n - 1][k - 1] + c[n - 1][k];
+		}
+	}
+};
+
+inline constexpr BinomTable BINOM{};
+
+// C(n, k), 0 outside 0 <= k <= n <= 52
+inline std::uint64_t binom(int n, int k)
+{
+	return (k < 0 || k > n || n < 0 || n > Card::N_CARDS) ? 0 : BINOM.c[n][k];
+}
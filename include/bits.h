@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+// Thin wrappers over the compiler bit intrinsics used by the bitboard code.
+// ctz64/clz64 are undefined for x == 0; callers check for an empty mask first.
+
+static inline int popcount64(std::uint64_t x)
+{
+	return __builtin_popcountll(x);
+}
+
+static inline int ctz64(std::uint64_t x)
+{
+	return __builtin_ctzll(x);
+}
+
+static inline int clz64(std::uint64_t x)
+{
+	return __builtin_clzll(x);
+}
+
+// Index of the highest set bit
+static inline int msb64(std::uint64_t x)
+{
+	return 63 - __builtin_clzll(x);
+}
+
+// Index of the n-th lowest set bit (n < popcount64(x))
+static inline int select64(std::uint64_t x, int n)
+{
+	for (; n > 0; n--)
+		x &= x - 1;
+	return __builtin_ctzll(x);
+}
+
+// Range over the indices of the set bits of a mask, lowest first:
+//   for (int id : BitIter(mask)) ...
+struct BitIter
+{
+	std::uint64_t m;
+
+	explicit BitIter(std::uint64_t m) : m(m) {}
+
+	BitIter begin() const { return *this; }
+	BitIter end() const { return BitIter(0); }
+
+	int operator*() const { return __builtin_ctzll(m); }
+	BitIter &operator++()
+	{
+		m &= m - 1;
+		return *this;
+	}
+	bool operator!=(const BitIter &rhs) const { return m != rhs.m; }
+};
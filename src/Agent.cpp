@@ -2,17 +2,19 @@
 
 #include "utils.h"
 
-std::atomic<int> Agent::next_id{0};
-
 Agent::Agent()
 {
-    player_id = next_id;
-    next_id++;
-    team_id = player_id % Hokm::N_TEAMS;
-    name = "AG_" + std::to_string(player_id);
+    name = name_tag;
     hand = Hand::EMPTY;
+}
+
+void Agent::set_seat(int seat)
+{
+    player_id = seat;
+    team_id = seat % Hokm::N_TEAMS;
+    name = name_tag + std::to_string(seat);
 
-    LOG("Agent(): name " << name << ", team " << team_id);
+    LOG("Agent::set_seat: name " << name << ", team " << team_id);
 }
 
 int Agent::get_id() const
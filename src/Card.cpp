@@ -10,74 +10,25 @@
 #include <stdexcept>
 #include <cassert>
 
-Card::Card() : su(NON_SU), rnk(NON_RNK), id(NON_ID) {}
-
-const Card Card::NONE = Card();
-
 const std::string Card::RNK_STR[] = {"2", "3", "4", "5", "6", "7", "8", "9",
 									 "X", "J", "Q", "K", "A", "-"};
 const std::string Card::SU_UNC_STR[] = {"\u2660", "\u2665", "\u2663", "\u2666", "-"};
 const std::string Card::SU_STR[] = {"S", "H", "C", "D", "-"};
 
-Card::Card(Cid id)
-{
-#ifdef DEBUG
-	if ((id >= N_CARDS && id != NON_ID) || id < 0)
-		throw std::invalid_argument("Card::Card(id): Invalid card id.");
-	if (id == NON_ID)
-		throw std::invalid_argument("Card::Card(id): You can't construct NONE card this way!");
-#endif
-	if (id == NON_ID || id >= N_CARDS || id < 0)
-	{
-		su = NON_SU;
-		rnk = NON_RNK;
-		this->id = NON_ID;
-	}
-	else
-	{
-		su = id / N_RANKS;
-		rnk = id % N_RANKS;
-		this->id = id;
-	}
-}
-
-Card::Card(Suit su, Rank rnk)
-{
-	if (su < 0 || su >= N_SUITS || rnk < two || rnk > Ace)
-	{
-		this->su = NON_SU;
-		this->rnk = NON_RNK;
-		this->id = NON_ID;
-	}
-	else
-	{
-		this->su = su;
-		this->rnk = rnk;
-		this->id = su * N_RANKS + rnk;
-	}
-}
-
 Card &Card::set(Suit su, Rank rnk)
 {
 	assert(su >= 0 && su < N_SUITS);
 	assert(rnk >= two && rnk <= Ace);
 
-	this->su = su;
-	this->rnk = rnk;
-	this->id = su * N_RANKS + rnk;
+	this->id = static_cast<std::uint8_t>(su * N_RANKS + rnk);
 
 	return *this;
 }
 
-Card::Card(std::string card_str)
+Card::Card(std::string card_str) : id(NON_ID)
 {
 	if (card_str.length() != 2)
-	{
-		su = NON_SU;
-		rnk = NON_RNK;
-		id = NON_ID;
 		return;
-	}
 
 	int r, s;
 	for (r = 0; r < N_RANKS; r++)
@@ -86,28 +37,18 @@ Card::Card(std::string card_str)
 	for (s = 0; s < N_SUITS; s++)
 		if (SU_STR[s][0] == card_str[1])
 			break;
-	if (s == NON_SU || r == NON_RNK)
-	{
-		su = NON_SU;
-		rnk = NON_RNK;
-		id = NON_ID;
-	}
-	else
-	{
-		su = (s);
-		rnk = (r);
-		id = (su)*N_RANKS + (rnk);
-	}
+	if (s != NON_SU && r != NON_RNK)
+		id = static_cast<std::uint8_t>(s * N_RANKS + r);
 }
 
 std::string Card::to_string() const
 {
-	return RNK_STR[rnk] + SU_STR[su];
+	return RNK_STR[rank()] + SU_STR[suit()];
 }
 
 std::string Card::to_unc_str() const
 {
-	return RNK_STR[rnk] + SU_UNC_STR[su];
+	return RNK_STR[rank()] + SU_UNC_STR[suit()];
 }
 
 #define REDonWHT "\033[31;107m"
@@ -118,17 +59,7 @@ std::string Card::to_color_unc_str() const
 {
 	if (id == NON_ID)
 		return "--";
-	return ((su % 2) ? REDonWHT : BLKonWHT) + RNK_STR[rnk] + SU_UNC_STR[su] + CLreset;
-}
-
-bool Card::operator==(const Card &rhs) const
-{
-	return id == rhs.id;
-}
-
-bool Card::operator!=(const Card &rhs) const
-{
-	return id != rhs.id;
+	return ((suit() % 2) ? REDonWHT : BLKonWHT) + RNK_STR[rank()] + SU_UNC_STR[suit()] + CLreset;
 }
 
 int Card::cmp(const Card &rhs, Suit led, Suit trump)
@@ -139,11 +70,12 @@ int Card::cmp(const Card &rhs, Suit led, Suit trump)
 // cl > cr ?
 int Card::cmp(const Card &cl, const Card &cr, Suit led, Suit trump)
 {
-	if (cl.su == cr.su)
+	const Suit l_su = cl.suit(), r_su = cr.suit();
+	if (l_su == r_su)
 	{
-		if (cl.rnk > cr.rnk)
+		if (cl.rank() > cr.rank())
 			return 1;
-		else if (cl.rnk == cr.rnk)
+		else if (cl.rank() == cr.rank())
 			return 0;
 		return -1;
 	}
@@ -151,11 +83,11 @@ int Card::cmp(const Card &cl, const Card &cr, Suit led, Suit trump)
 		return 1;
 	if (cl == NONE && cr != NONE)
 		return -1;
-	if (cl.su == trump)
+	if (l_su == trump)
 		return 1;
-	if (cl.su == led && cr.su != trump)
+	if (l_su == led && r_su != trump)
 		return 1;
-	if (cl.su != led && cl.su != trump && cr.su != led && cr.su != trump)
+	if (l_su != led && l_su != trump && r_su != led && r_su != trump)
 		return 0;
 	return -1;
 }
@@ -10,28 +10,26 @@
 #include <stdexcept>
 #include <string>
 
-CardStack::CardStack() : nbr_cards(0), bin64(0), mt_rnd_gen(std::mt19937(std::random_device()())) {}
+CardStack::CardStack() : nbr_cards(0), bin64(0) {}
 
 const CardStack CardStack::EMPTY = CardStack();
 
 
-CardStack::CardStack(uint64_t bin64) : nbr_cards(0), mt_rnd_gen(std::mt19937(std::random_device()())) {
+CardStack::CardStack(uint64_t bin64) : nbr_cards(0) {
 	this->bin64 = bin64 & (~0ull << (64 - Card::N_CARDS) >> (64 - Card::N_CARDS));
 	for (Cid id = 0; id < Card::N_CARDS; id++)
-		if (this->bin64 & (1ull << id)) {
+		if (this->bin64 & (1ull << id))
 			append(Card(id));
-			nbr_cards++;
-		}
 }
 
-CardStack::CardStack(const Cid ids_arr[], int nbr_cards) : nbr_cards(0), bin64(0), mt_rnd_gen(std::mt19937(std::random_device()()))
+CardStack::CardStack(const Cid ids_arr[], int nbr_cards) : nbr_cards(0), bin64(0)
 {
 	for(int i = 0; i < nbr_cards; i++){
 		append(Card(ids_arr[i]));
 	}
 }
 
-CardStack::CardStack(const Card cards[], int nbr_cards) : nbr_cards(0), bin64(0), mt_rnd_gen(std::mt19937(std::random_device()()))
+CardStack::CardStack(const Card cards[], int nbr_cards) : nbr_cards(0), bin64(0)
 {
 	for(int i = 0; i < nbr_cards; i++)
 		append(cards[i]);
@@ -95,19 +93,16 @@ CardStack& CardStack::append(const Card card_arr[], int nbr_cards) {
 
 CardStack& CardStack::append(const Hand& h)
 {
-	Card c = Card::NONE;
-	for(Suit s = 0; s < Card::N_SUITS; s++)
-		for(int i = 0; i < h.len[s]; i++)
-			append(c.set(s, h.cards[s][i]));
+	for (Cid id : BitIter(h.bin64))
+		append(Card(id));
 	return *this;
 }
 
-CardStack& CardStack::shuffle() {
+CardStack& CardStack::shuffle(Rng &rng) {
 	if (!nbr_cards)
 		return *this;
 	for (int i = 0; i < nbr_cards - 1; i++) {
-		std::uniform_int_distribution<int> uint_rnd_dist(i, nbr_cards - 1);
-		int j = uint_rnd_dist(mt_rnd_gen);
+		int j = i + rng.below(nbr_cards - i);
 		if (j != i) {
 			Card tmp = cards_arr[i];
 			cards_arr[i] = cards_arr[j];
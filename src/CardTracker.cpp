@@ -0,0 +1,82 @@
+#include "CardTracker.h"
+
+#include <stdexcept>
+
+#include "Hand.h"
+#include "bits.h"
+
+void CardTracker::reset(std::uint64_t unseen, int n_each)
+{
+	for (int s = 0; s < N_SEATS; s++)
+	{
+		now.poss[s] = unseen;
+		now.count[s] = n_each;
+	}
+	depth = 0;
+	propagate();
+}
+
+bool CardTracker::play(int seat, const Card &c, Suit led)
+{
+	if (depth == int(before.size()))
+		throw std::length_error("CardTracker::play: more plays than cards");
+	before[depth++] = now;
+	const std::uint64_t bit = 1ull << c.id;
+	const bool held = now.poss[seat] & bit;
+	for (int s = 0; s < N_SEATS; s++)
+		now.poss[s] &= ~bit;
+	if (led != Card::NON_SU && c.suit() != led)
+		now.poss[seat] &= ~Hand::suit_mask(led);
+	now.count[seat]--;
+	propagate();
+	return held;
+}
+
+void CardTracker::undo()
+{
+	if (depth == 0)
+		throw std::logic_error("CardTracker::undo: no play to take back");
+	now = before[--depth];
+}
+
+std::uint64_t CardTracker::sure(int seat) const
+{
+	return now.poss[seat] & ~(now.poss[(seat + 1) % N_SEATS] | now.poss[(seat + 2) % N_SEATS]);
+}
+
+CardConstraints CardTracker::constraints() const
+{
+	const std::uint64_t A = now.poss[0], B = now.poss[1], C = now.poss[2];
+	return CardConstraints{A & ~B & ~C, B & ~A & ~C, C & ~A & ~B, A & B & ~C, B & C & ~A, C & A & ~B, A & B & C,
+						   now.count[0], now.count[1], now.count[2]};
+}
+
+void CardTracker::propagate()
+{
+	// Every change drops a card from a seat, so this ends after a few rounds.
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (int s = 0; s < N_SEATS; s++)
+		{
+			std::uint64_t &p = now.poss[s];
+			std::uint64_t &q = now.poss[(s + 1) % N_SEATS];
+			std::uint64_t &r = now.poss[(s + 2) % N_SEATS];
+			const std::uint64_t shared = p & (q | r);
+			if (!shared)
+				continue;
+			if (popcount64(p & ~shared) == now.count[s])
+			{
+				p &= ~shared;
+				changed = true;
+			}
+			else if (popcount64(p) == now.count[s])
+			{
+				q &= ~p;
+				r &= ~p;
+				changed = true;
+			}
+		}
+	}
+}
@@ -0,0 +1,113 @@
+/*
+ * CardTracker_test.cpp
+ */
+#include "CardTracker.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "GameConfig.h"
+#include "Hand.h"
+#include "Rng.h"
+#include "bits.h"
+
+namespace {
+CardConstraints sets_of(const std::uint64_t poss[3], const int count[3])
+{
+	const std::uint64_t A = poss[0], B = poss[1], C = poss[2];
+	return CardConstraints{A & ~B & ~C, B & ~A & ~C, C & ~A & ~B, A & B & ~C, B & C & ~A, C & A & ~B, A & B & C,
+						   count[0], count[1], count[2]};
+}
+
+bool same(const CardConstraints &x, const CardConstraints &y)
+{
+	return x.a == y.a && x.b == y.b && x.c == y.c && x.ab == y.ab && x.bc == y.bc && x.ca == y.ca &&
+		   x.abc == y.abc && x.n_a == y.n_a && x.n_b == y.n_b && x.n_c == y.n_c;
+}
+}
+
+void CardTracker_test()
+{
+	// a hand-made round: a shows out of spades, runs out of cards, and b
+	// shows out of hearts, which leaves the last heart to c
+	{
+		const Card S0(0, 0), S1(0, 1), S2(0, 2), H0(1, 0), H1(1, 1), H2(1, 2);
+		CardTracker tr;
+		tr.reset(Hand().add(S0).add(S1).add(S2).add(H0).add(H1).add(H2).bin64, 2);
+		tr.play(0, H0, 0);
+		tr.play(1, S0, 0);
+		tr.play(2, S2, 0);
+		if (tr.possible(0) != Hand().add(H1).add(H2).bin64)
+			throw std::runtime_error("CardTracker_test: void not applied");
+		tr.play(0, H1, Card::NON_SU);
+		if (tr.possible(0) != 0)
+			throw std::runtime_error("CardTracker_test: empty seat still holds cards");
+		if (!tr.play(1, S1, 1) || tr.sure(2) != Hand().add(H2).bin64 || tr.possible(1) != 0)
+			throw std::runtime_error("CardTracker_test: last card not forced");
+		for (int k = 0; k < 3; k++)
+			tr.undo();
+		if (tr.possible(0) != Hand().add(H1).add(H2).bin64 || tr.count(0) != 1 || tr.nbr_plays() != 2)
+			throw std::runtime_error("CardTracker_test: undo did not restore the state");
+	}
+
+	// Random rounds with players following suit: the tracker must keep every
+	// card with its owner, agree with the counts, lose no deal consistent
+	// with the plays and voids alone, and undo back to the deal.
+	Rng rng(25);
+	for (int round = 0; round < 40; round++)
+	{
+		Cid ids[Card::N_CARDS];
+		for (Cid id = 0; id < Card::N_CARDS; id++)
+			ids[id] = id;
+		for (int i = Card::N_CARDS - 1; i > 0; i--)
+			std::swap(ids[i], ids[rng.below(i + 1)]);
+		// seat 3 is the observer
+		std::uint64_t hands[4] = {};
+		for (int i = 0; i < Card::N_CARDS; i++)
+			hands[i % 4] |= 1ull << ids[i];
+
+		CardTracker tr;
+		tr.reset(Hand::ALL_MASK & ~hands[3], Hokm::N_DELT);
+		const CardConstraints start = tr.constraints();
+		std::uint64_t raw[3] = {tr.possible(0), tr.possible(1), tr.possible(2)};
+		int count[3] = {Hokm::N_DELT, Hokm::N_DELT, Hokm::N_DELT};
+
+		int leader = rng.below(4);
+		for (int t = 0; t < Hokm::N_TRICKS; t++)
+		{
+			Suit led = Card::NON_SU;
+			for (int k = 0; k < 4; k++)
+			{
+				const int pl = (leader + k) % 4;
+				std::uint64_t legal = hands[pl];
+				if (led != Card::NON_SU && (hands[pl] & Hand::suit_mask(led)))
+					legal &= Hand::suit_mask(led);
+				const Card c(select64(legal, rng.below(popcount64(legal))));
+				hands[pl] &= ~(1ull << c.id);
+				if (pl != 3)
+				{
+					if (!tr.play(pl, c, led))
+						throw std::runtime_error("CardTracker_test: owner had lost the card");
+					for (int s = 0; s < 3; s++)
+						raw[s] &= ~(1ull << c.id);
+					if (led != Card::NON_SU && c.suit() != led)
+						raw[pl] &= ~Hand::suit_mask(led);
+					count[pl]--;
+				}
+				if (led == Card::NON_SU)
+					led = c.suit();
+			}
+			leader = rng.below(4);
+
+			for (int s = 0; s < 3; s++)
+				if ((hands[s] & ~tr.possible(s)) || (tr.sure(s) & ~hands[s]) || tr.count(s) != count[s])
+					throw std::runtime_error("CardTracker_test: sets or counts off the deal");
+			if (DealSampler::count(tr.constraints()) != DealSampler::count(sets_of(raw, count)))
+				throw std::runtime_error("CardTracker_test: propagation lost consistent deals");
+		}
+		while (tr.nbr_plays())
+			tr.undo();
+		if (!same(tr.constraints(), start))
+			throw std::runtime_error("CardTracker_test: undo did not get back to the deal");
+	}
+}
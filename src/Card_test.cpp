@@ -75,6 +75,16 @@ void Card_test(){
 			  << " ; cmp(d, c) : " << Card::cmp(d, c, led, trump) << ", "
 			  << " ; cmp(c, d) : " << Card::cmp(c, d, led, trump) << std::endl;
 
+	std::cout << "sizeof(Card): " << sizeof(Card) << ", NONE su/rnk: " << Card::NONE.suit()
+			  << "/" << Card::NONE.rank() << std::endl;
+	int n_ok = 0;
+	for (Cid id = 0; id < Card::N_CARDS; id++)
+	{
+		Card e(id);
+		if (Card(e.suit(), e.rank()) == e && Card(e.to_string()) == e && e.id == id)
+			n_ok++;
+	}
+	std::cout << "id/suit/rank/string round trips: " << n_ok << "/" << Card::N_CARDS << std::endl;
 }
 
 
@@ -0,0 +1,138 @@
+#include "DealSampler.h"
+
+#include <algorithm>
+
+#include "binom.h"
+#include "bits.h"
+
+namespace {
+// Takes k cards of `pool` uniformly at random out of it.
+std::uint64_t take(std::uint64_t &pool, int k, Rng &rng)
+{
+	int n = popcount64(pool);
+	// drawing the cards left behind is cheaper past half the pool
+	const bool keep = 2 * k > n;
+	std::uint64_t out = 0;
+	for (int m = keep ? n - k : k; m > 0; m--, n--)
+		out |= 1ull << select64(pool & ~out, rng.below(n));
+	if (keep)
+		out = pool & ~out;
+	pool &= ~out;
+	return out;
+}
+
+// Calls fn(x, y, z, u, v, deals) for every split of `cons` with deals > 0:
+// x of the Hab cards go to a, y of Hbc to b, z of Hca to c, u and v of Habc
+// to a and b.
+template <class Fn>
+void for_each_split(const CardConstraints &cons, Fn &&fn)
+{
+	const int ab = popcount64(cons.ab), bc = popcount64(cons.bc), ca = popcount64(cons.ca),
+			  abc = popcount64(cons.abc);
+	const int need_a = cons.n_a - popcount64(cons.a);
+	const int need_b = cons.n_b - popcount64(cons.b);
+	const int need_c = cons.n_c - popcount64(cons.c);
+	if (need_a < 0 || need_b < 0 || need_c < 0 || need_a + need_b + need_c != ab + bc + ca + abc ||
+		need_a > Card::N_RANKS || need_b > Card::N_RANKS || need_c > Card::N_RANKS)
+		return;
+
+	// each range has at most N_RANKS + 1 values
+	for (int x = std::max(0, ab - need_b); x <= std::min(ab, need_a); x++)
+		for (int y = std::max(0, bc - need_c); y <= std::min(bc, need_b); y++)
+			for (int z = std::max(0, ca - need_a); z <= std::min(ca, need_c); z++)
+			{
+				// Habc cards to a and to b; c takes the rest
+				const int u = need_a - x - (ca - z);
+				const int v = need_b - (ab - x) - y;
+				if (u < 0 || v < 0 || u + v > abc)
+					continue;
+				fn(x, y, z, u, v, binom(ab, x) * binom(bc, y) * binom(ca, z) * binom(abc, u) * binom(abc - u, v));
+			}
+}
+}
+
+DealSampler::DealSampler(const CardConstraints &cons) : cons(cons), total(0), nbr_splits(0)
+{
+	need_a = cons.n_a - popcount64(cons.a);
+	need_b = cons.n_b - popcount64(cons.b);
+	for_each_split(cons, [this](int x, int y, int z, int, int, std::uint64_t deals)
+	{
+		total += deals;
+		cum[nbr_splits] = total;
+		splits[nbr_splits++] = Split{std::uint8_t(x), std::uint8_t(y), std::uint8_t(z)};
+	});
+}
+
+std::uint64_t DealSampler::count(const CardConstraints &cons)
+{
+	std::uint64_t n = 0;
+	for_each_split(cons, [&n](int, int, int, int, int, std::uint64_t deals) { n += deals; });
+	return n;
+}
+
+CardConstraints DealSampler::exclude(const CardConstraints &cons, std::uint64_t s_a, std::uint64_t s_b,
+									 std::uint64_t s_c)
+{
+	const std::uint64_t all = cons.a | cons.b | cons.c | cons.ab | cons.bc | cons.ca | cons.abc;
+	const std::uint64_t A = (cons.a | cons.ab | cons.ca | cons.abc) & ~s_a;
+	const std::uint64_t B = (cons.b | cons.ab | cons.bc | cons.abc) & ~s_b;
+	const std::uint64_t C = (cons.c | cons.bc | cons.ca | cons.abc) & ~s_c;
+	CardConstraints out{A & ~B & ~C, B & ~A & ~C, C & ~A & ~B, A & B & ~C, B & C & ~A, C & A & ~B, A & B & C,
+						cons.n_a, cons.n_b, cons.n_c};
+	// a card no seat may hold: nothing is consistent
+	if (all & ~(A | B | C))
+		out.n_a = -1;
+	return out;
+}
+
+void DealSampler::marginals(ProbHand &pa, ProbHand &pb, ProbHand &pc) const
+{
+	pa.clear();
+	pb.clear();
+	pc.clear();
+	if (total == 0)
+		return;
+	// Cards of one set are exchangeable, so each of them goes to a seat as
+	// often as the set's mean share for that seat.
+	long double ex = 0, ey = 0, ez = 0, eu = 0, ev = 0, prev = 0;
+	const int ca = popcount64(cons.ca), ab = popcount64(cons.ab);
+	for (int i = 0; i < nbr_splits; i++)
+	{
+		const long double w = (long double)(cum[i]) - prev;
+		prev = (long double)(cum[i]);
+		const Split &s = splits[i];
+		ex += w * s.x;
+		ey += w * s.y;
+		ez += w * s.z;
+		eu += w * (need_a - s.x - (ca - s.z));
+		ev += w * (need_b - (ab - s.x) - s.y);
+	}
+	auto share = [this](long double e, std::uint64_t set)
+	{ return set ? std::min(1.0, double(e / (long double)(total) / popcount64(set))) : 0.0; };
+	const double p_ab = share(ex, cons.ab), p_bc = share(ey, cons.bc), p_ca = share(ez, cons.ca);
+	const double p_abc_a = share(eu, cons.abc), p_abc_b = share(ev, cons.abc);
+
+	pa.update(Hand(cons.a), 1).update(Hand(cons.ab), p_ab).update(Hand(cons.ca), 1 - p_ca)
+		.update(Hand(cons.abc), p_abc_a);
+	pb.update(Hand(cons.b), 1).update(Hand(cons.ab), 1 - p_ab).update(Hand(cons.bc), p_bc)
+		.update(Hand(cons.abc), p_abc_b);
+	pc.update(Hand(cons.c), 1).update(Hand(cons.bc), 1 - p_bc).update(Hand(cons.ca), p_ca)
+		.update(Hand(cons.abc), std::max(0.0, 1 - p_abc_a - p_abc_b));
+}
+
+bool DealSampler::sample(Rng &rng, std::uint64_t hands[3]) const
+{
+	if (total == 0)
+		return false;
+	const std::uint64_t r = rng.below64(total);
+	const Split &s = splits[std::upper_bound(cum, cum + nbr_splits, r) - cum];
+	const int u = need_a - s.x - (popcount64(cons.ca) - s.z);
+	const int v = need_b - (popcount64(cons.ab) - s.x) - s.y;
+
+	std::uint64_t ab = cons.ab, bc = cons.bc, ca = cons.ca, abc = cons.abc;
+	hands[0] = cons.a | take(ab, s.x, rng) | take(abc, u, rng);
+	hands[1] = cons.b | ab | take(bc, s.y, rng) | take(abc, v, rng);
+	hands[2] = cons.c | bc | take(ca, s.z, rng) | abc;
+	hands[0] |= ca;
+	return true;
+}
@@ -0,0 +1,147 @@
+/*
+ * DealSampler_test.cpp
+ */
+#include "DealSampler.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#include "bits.h"
+
+namespace {
+// Random constraints around a known deal of up to 13 cards per seat:
+// each card goes to a set that includes its true owner.
+CardConstraints loose_constraints(Rng &rng, int per_seat, std::uint64_t truth[3])
+{
+	truth[0] = truth[1] = truth[2] = 0;
+	Cid ids[Card::N_CARDS];
+	for (Cid id = 0; id < Card::N_CARDS; id++)
+		ids[id] = id;
+	for (int i = Card::N_CARDS - 1; i > 0; i--)
+		std::swap(ids[i], ids[rng.below(i + 1)]);
+	for (int i = 0; i < 3 * per_seat; i++)
+		truth[i % 3] |= 1ull << ids[i];
+	CardConstraints cons{};
+	std::uint64_t *sets[8] = {nullptr, &cons.a, &cons.b, &cons.ab, &cons.c, &cons.ca, &cons.bc, &cons.abc};
+	for (int s = 0; s < 3; s++)
+		for (Cid id : BitIter(truth[s]))
+			*sets[1 << s | rng.below(8)] |= 1ull << id;
+	cons.n_a = cons.n_b = cons.n_c = per_seat;
+	return cons;
+}
+
+bool consistent(const CardConstraints &cons, const std::uint64_t h[3])
+{
+	const std::uint64_t allowed[3] = {cons.a | cons.ab | cons.ca | cons.abc, cons.b | cons.ab | cons.bc | cons.abc,
+									  cons.c | cons.bc | cons.ca | cons.abc};
+	const std::uint64_t all = cons.a | cons.b | cons.c | cons.ab | cons.bc | cons.ca | cons.abc;
+	return !(h[0] & h[1]) && !(h[1] & h[2]) && !(h[0] & h[2]) && (h[0] | h[1] | h[2]) == all &&
+		   popcount64(h[0]) == cons.n_a && popcount64(h[1]) == cons.n_b && popcount64(h[2]) == cons.n_c &&
+		   !(h[0] & ~allowed[0]) && !(h[1] & ~allowed[1]) && !(h[2] & ~allowed[2]);
+}
+}
+
+void DealSampler_test()
+{
+	Rng rng(15);
+
+	// full-size constraints: every draw is consistent
+	int bad = 0;
+	const int nbr_draws = 20000;
+	for (int d = 0; d < nbr_draws / 1000; d++)
+	{
+		std::uint64_t truth[3];
+		const CardConstraints cons = loose_constraints(rng, 1 + rng.below(Card::N_RANKS), truth);
+		DealSampler sampler(cons);
+		bad += (sampler.count() == 0);
+		for (int k = 0; k < 1000; k++)
+		{
+			std::uint64_t h[3];
+			bad += !sampler.sample(rng, h) || !consistent(cons, h);
+		}
+	}
+
+	// small constraints: exact count and uniform draws against enumeration
+	int bad_count = 0;
+	double worst_chi2 = 0, worst_marginal = 0;
+	for (int d = 0; d < 10; d++)
+	{
+		std::uint64_t truth[3];
+		const CardConstraints cons = loose_constraints(rng, 3, truth);
+		const std::uint64_t all = truth[0] | truth[1] | truth[2];
+		Cid ids[9];
+		int n = 0;
+		for (Cid id : BitIter(all))
+			ids[n++] = id;
+		// a random set a may not hold
+		const std::uint64_t s_a = all & rng();
+		std::map<std::pair<std::uint64_t, std::uint64_t>, int> freq;
+		double held[3][9] = {};
+		std::uint64_t nbr_excl = 0;
+		for (int code = 0; code < 19683; code++) // 3^9 seat assignments
+		{
+			std::uint64_t h[3] = {0};
+			for (int i = 0, c = code; i < n; i++, c /= 3)
+				h[c % 3] |= 1ull << ids[i];
+			if (!consistent(cons, h))
+				continue;
+			freq[{h[0], h[1]}] = 0;
+			nbr_excl += !(h[0] & s_a);
+			for (int i = 0, c = code; i < n; i++, c /= 3)
+				held[c % 3][i]++;
+		}
+		DealSampler sampler(cons);
+		bad_count += (sampler.count() != freq.size()) || DealSampler::count(cons) != sampler.count() ||
+					 DealSampler::count(DealSampler::exclude(cons, s_a, 0)) != nbr_excl;
+		ProbHand p[3];
+		sampler.marginals(p[0], p[1], p[2]);
+		for (int s = 0; s < 3; s++)
+			for (int i = 0; i < n; i++)
+				worst_marginal = std::max(worst_marginal,
+										  std::abs(p[s].getProb(Card(ids[i])) - held[s][i] / freq.size()));
+		const int per_deal = 400;
+		const int draws = per_deal * int(freq.size());
+		for (int k = 0; k < draws; k++)
+		{
+			std::uint64_t h[3];
+			sampler.sample(rng, h);
+			auto it = freq.find({h[0], h[1]});
+			if (it == freq.end())
+				bad_count++;
+			else
+				it->second++;
+		}
+		double chi2 = 0;
+		for (auto &f : freq)
+			chi2 += double(f.second - per_deal) * (f.second - per_deal) / per_deal;
+		// normalized: (chi2 - df) / sqrt(2 df)
+		const double df = double(freq.size()) - 1;
+		if (df > 0)
+			worst_chi2 = std::max(worst_chi2, (chi2 - df) / std::sqrt(2 * df));
+	}
+
+	// throughput on a mid-round position
+	std::uint64_t truth[3];
+	const CardConstraints cons = loose_constraints(rng, 9, truth);
+	const DealSampler sampler(cons);
+	std::uint64_t h[3], sink = 0;
+	const int nbr_timed = 200000;
+	auto t0 = std::chrono::steady_clock::now();
+	for (int k = 0; k < nbr_timed; k++)
+	{
+		sampler.sample(rng, h);
+		sink ^= h[0];
+	}
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+	std::cout << "DealSampler draws: " << nbr_draws << ", inconsistent: " << bad << "; small cases: count/support "
+			  << "mismatches " << bad_count << ", worst normalized chi2 " << worst_chi2 << ", worst marginal error "
+			  << worst_marginal << "; "
+			  << int(nbr_timed / ms) << " deals/ms (" << (sink & 1) << ")" << std::endl;
+	if (bad || bad_count || worst_chi2 > 6 || worst_marginal > 1e-9)
+		throw std::runtime_error("DealSampler_test: draws are inconsistent or not uniform");
+}
@@ -10,22 +10,21 @@
 #include "GameConfig.h"
 
 #include <iostream>
+#include <random>
 
-Deck::Deck()
-    : outside(false), mt_rnd_gen(std::mt19937(std::random_device()())) {
+Deck::Deck() : outside(false) {
   for (int i = 0; i < Card::N_CARDS; i++)
     cards[i] = Card(i);
 }
 
-Deck::Deck(const CardStack &out_deck)
-    : outside(true), mt_rnd_gen(std::mt19937(std::random_device()())) {
+Deck::Deck(const CardStack &out_deck) : outside(true) {
   for (int i = 0; i < out_deck.get_nbr_cards(); i++)
     cards[i] = out_deck.at(i);
 }
 
 CardStack Deck::to_cardStack() const { return CardStack(cards, Card::N_CARDS); }
 
-void Deck::shuffle_overhand(int cmplx) {
+void Deck::shuffle_overhand(Rng &rng, int cmplx) {
   if (cmplx < 1)
     return;
 
@@ -47,7 +46,7 @@ void Deck::shuffle_overhand(int cmplx) {
 
     int pos = 0;
     while (pos < n) {
-      int sz = 1 + geo(mt_rnd_gen);
+      int sz = 1 + geo(rng);
       if (sz > n - pos)
         sz = n - pos;
       packets.emplace_back();
@@ -67,7 +66,7 @@ void Deck::shuffle_overhand(int cmplx) {
   }
 }
 
-void Deck::shuffle_riffle(int cmplx) {
+void Deck::shuffle_riffle(Rng &rng, int cmplx) {
   if (cmplx < 1)
     return;
 
@@ -93,7 +92,7 @@ void Deck::shuffle_riffle(int cmplx) {
         tmp[out++] = cards[left++];
         continue;
       }
-      if (coin(mt_rnd_gen))
+      if (coin(rng))
         tmp[out++] = cards[left++];
       else
         tmp[out++] = cards[right++];
@@ -108,10 +107,9 @@ void Deck::shuffle_riffle(int cmplx) {
   }
 }
 
-void Deck::shuffle_rnd() {
+void Deck::shuffle_rnd(Rng &rng) {
   for (int i = 0; i < Card::N_CARDS - 1; i++) {
-    std::uniform_int_distribution<int> int_rnd_dist(i, Card::N_CARDS - 1);
-    int j = int_rnd_dist(mt_rnd_gen);
+    int j = i + rng.below(Card::N_CARDS - i);
     if (j != i) {
       Card tmp = cards[i];
       cards[i] = cards[j];
@@ -120,21 +118,20 @@ void Deck::shuffle_rnd() {
   }
 }
 
-void Deck::shuffle(int cmplx) {
+void Deck::shuffle(Rng &rng, int cmplx) {
   for (int i = 0; i < cmplx; i++) {
-    shuffle_overhand(1);
-    shuffle_riffle(1);
+    shuffle_overhand(rng, 1);
+    shuffle_riffle(rng, 1);
   }
 }
 
-void Deck::shuffle_rnd_bag() {
+void Deck::shuffle_rnd_bag(Rng &rng) {
   int nbr_delt = Card::N_CARDS / Hokm::N_PLAYERS;
   for (int s = 0; s < Hokm::N_PLAYERS - 1; s++) {
-    std::uniform_int_distribution<int> int_rnd_dist(0, Hokm::N_PLAYERS - s - 1);
     int i_min = s * nbr_delt;
     int i_max = i_min + nbr_delt;
     for (int i = i_min; i < i_max; i++) {
-      int j = int_rnd_dist(mt_rnd_gen);
+      int j = rng.below(Hokm::N_PLAYERS - s);
       if (j) {
         int i_j = i + j * nbr_delt;
         Card tmp = cards[i];
@@ -145,8 +142,8 @@ void Deck::shuffle_rnd_bag() {
   }
 }
 
-void Deck::shuffle_deal(CardStack *stacks, int opening_player, int cmplx) {
-  shuffle(cmplx);
+void Deck::shuffle_deal(Rng &rng, CardStack *stacks, int opening_player, int cmplx) {
+  shuffle(rng, cmplx);
   deal(stacks, opening_player);
 }
 
@@ -16,8 +16,9 @@ void Deck_test()
 {
 	CardStack h[4];
 	Deck dk;
+	Rng rng(1);
 	for(int i = 0; i < 2; i++) {
-		dk.shuffle_deal(h, 4);
+		dk.shuffle_deal(rng, h, 4);
 		for(int j = 0; j < 4; j++)
 			std::cout << h[j].to_string() << std::endl;
 	std::cout << "------------------------------------------" << std::endl;
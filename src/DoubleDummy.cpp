@@ -0,0 +1,597 @@
+#include "DoubleDummy.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "Trick.h"
+#include "Zobrist.h"
+#include "bits.h"
+
+DoubleDummy::DoubleDummy(int tt_log2) : nbr_nodes(0)
+{
+	if (tt_log2 < 2 || tt_log2 > 30)
+		throw std::invalid_argument("DoubleDummy: tt_log2 out of [2, 30]");
+	tt.resize(std::size_t(1) << tt_log2);
+	tt_mask = tt.size() / WAYS - 1;
+	clear();
+}
+
+void DoubleDummy::clear()
+{
+	// always-true bounds, so an empty slot can never mislead a probe
+	std::fill(tt.begin(), tt.end(), Entry{0, {0, 0, 0, 0}, 0, 0, Hokm::N_TRICKS, -1, 0});
+	std::fill(std::begin(killer), std::end(killer), Card::NONE);
+	for (auto &h : history)
+		std::fill(std::begin(h), std::end(h), 0u);
+	nbr_nodes = 0;
+}
+
+std::array<int, Hokm::N_TEAMS> DoubleDummy::solve(const RoundState &st)
+{
+	RoundState s = st;
+	const int left = Hokm::N_TRICKS - s.trick_id;
+	const int v = value(s, -1);
+	return {s.team_scores[0] + v, s.team_scores[1] + left - v};
+}
+
+int DoubleDummy::solve_moves(const RoundState &st, Card cards[], int tricks[], Clock::time_point stop)
+{
+	stop_at = stop;
+	stopped = false;
+	RoundState s = st;
+	const int team = s.turn() % Hokm::N_TEAMS;
+	const int left = Hokm::N_TRICKS - s.trick_id;
+	const std::uint64_t legal = s.legal();
+	int n = 0;
+	for (Cid id : BitIter(legal))
+		cards[n++] = Card(id);
+
+	Card reps[Card::N_RANKS];
+	const int nbr_reps = ordered_moves(s, reps);
+	// each card's value is the first guess for the next
+	int guess = -1;
+	for (int r = 0; r < nbr_reps; r++)
+	{
+		const std::uint64_t eq = equivalents(s, reps[r]);
+		const int w = s.play(reps[r]);
+		const int gain = (w >= 0 && w % Hokm::N_TEAMS == 0);
+		const int v = gain + value(s, guess < 0 ? -1 : guess - gain);
+		guess = v;
+		s.undo();
+		if (stopped)
+		{
+			stop_at = Clock::time_point::max();
+			return 0;
+		}
+		const int got = s.team_scores[team] + (team == 0 ? v : left - v);
+		for (int i = 0; i < n; i++)
+			if (eq >> cards[i].id & 1)
+				tricks[i] = got;
+	}
+	stop_at = Clock::time_point::max();
+	return n;
+}
+
+int DoubleDummy::value(RoundState &st, int guess)
+{
+	int lo = 0;
+	int hi = Hokm::N_TRICKS - st.trick_id;
+	if (hi > 0)
+		shapes[st.trick_id] = shape(st);
+	int mid = guess < 0 ? (lo + hi + 1) / 2 : guess;
+	while (lo < hi)
+	{
+		// probe next to the last result: a fail-soft bound is often exact
+		mid = std::max(lo + 1, std::min(mid, hi));
+		std::uint64_t rel;
+		const int v = search(st, mid - 1, mid, rel);
+		if (v >= mid)
+			lo = v, mid = v + 1;
+		else
+			hi = v, mid = v;
+	}
+	return lo;
+}
+
+int DoubleDummy::search(RoundState &st, int alpha, int beta, std::uint64_t &rel)
+{
+	nbr_nodes++;
+	rel = 0;
+	if (nbr_nodes % CLOCK_EVERY == 0 && stop_at != Clock::time_point::max() && Clock::now() >= stop_at)
+		stopped = true;
+	if (stopped)
+		return 0;
+	const int left = Hokm::N_TRICKS - st.trick_id;
+	if (beta <= 0)
+		return 0;
+	if (alpha >= left)
+		return left;
+	if (st.ord == 0)
+	{
+		if (left == 1)
+		{
+			Card last[Hokm::N_PLAYERS];
+			for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+				last[pl] = Card(ctz64(st.hand[pl]));
+			const int w = Hokm::trick_winner(last, last[st.leader].suit(), st.trump);
+			rel = rank_winner(last, last[w]);
+			return w % Hokm::N_TEAMS == 0;
+		}
+		int sure[Hokm::N_TEAMS];
+		std::uint64_t seen[Hokm::N_TEAMS];
+		sure_tricks(st, sure, seen);
+		if (sure[0] >= beta)
+		{
+			rel = seen[0];
+			return sure[0];
+		}
+		if (left - sure[1] <= alpha)
+		{
+			rel = seen[1];
+			return left - sure[1];
+		}
+		// cards on the table count as their seat's, so the shape holds for
+		// the whole trick
+		shapes[st.trick_id] = shape(st);
+	}
+	const Shape &sh = shapes[st.trick_id];
+	const std::uint32_t ctx = std::uint32_t(st.leader) | std::uint32_t(st.trump) << 2 | table_key(st) << 4;
+
+	// the last two cards of a trick are settled faster than probed
+	Entry *bucket = nullptr;
+	const Entry *hint = nullptr;
+	if (st.ord < 2)
+	{
+		bucket = &tt[(((sh.lengths ^ ctx * 0x9e3779b97f4a7c15ull) * 0xbf58476d1ce4e5b9ull) >> 32 & tt_mask) * WAYS];
+		for (int i = 0; i < WAYS; i++)
+		{
+			const Entry &e = bucket[i];
+			if (!matches(e, sh, ctx))
+				continue;
+			if (e.lo >= beta || e.hi <= alpha)
+			{
+				rel = region(st, e);
+				return e.lo >= beta ? e.lo : e.hi;
+			}
+			if (!hint && e.best_su >= 0)
+				hint = &e;
+		}
+	}
+
+	const bool max_node = st.turn() % Hokm::N_TEAMS == 0;
+	Card mv[Card::N_RANKS];
+	const int n = ordered_moves(st, mv);
+	const std::uint64_t live = st.hand[0] | st.hand[1] | st.hand[2] | st.hand[3];
+	if (hint)
+	{
+		// the card that did best here last time, found by its place among
+		// the live cards of its suit, goes first
+		const std::uint64_t su_live = live & Hand::suit_mask(hint->best_su);
+		if (hint->best_pos < popcount64(su_live))
+			to_front(st, mv, n, Card(select64(su_live, popcount64(su_live) - 1 - hint->best_pos)));
+	}
+	else if (st.ord == 0 && killer[st.trick_id] != Card::NONE)
+		to_front(st, mv, n, killer[st.trick_id]); // the last lead that cut at this trick
+	int best = max_node ? -1 : Hokm::N_TRICKS + 1;
+	Card best_mv = Card::NONE;
+	int a = alpha, b = beta;
+	std::uint64_t child_rel = 0;
+	// own cards known to do no better than one already searched
+	const std::uint64_t own = st.hand[st.turn()];
+	std::uint64_t covered = 0;
+	for (int i = 0; i < n && a < b; i++)
+	{
+		if (covered >> mv[i].id & 1)
+			continue;
+		const int w = st.play(mv[i]);
+		const int gain = (w >= 0 && w % Hokm::N_TEAMS == 0);
+		const int v = gain + search(st, a - gain, b - gain, child_rel);
+		if (stopped)
+		{
+			st.undo();
+			return 0;
+		}
+		if (w >= 0)
+		{
+			Card trick[Hokm::N_PLAYERS], win;
+			for (int k = 0; k < Hokm::N_PLAYERS; k++)
+			{
+				const RoundState::Move &m = st.moves[st.nbr_moves - Hokm::N_PLAYERS + k];
+				trick[k] = m.card;
+				if (m.pl == w)
+					win = m.card;
+			}
+			child_rel |= rank_winner(trick, win);
+		}
+		st.undo();
+		rel |= child_rel;
+		{
+			// a card below every card of its suit the result rested on
+			// gets the same result as any other such card
+			const std::uint64_t su_mask = Hand::suit_mask(mv[i].suit());
+			const std::uint64_t r = child_rel & su_mask;
+			const std::uint64_t below = r ? ((1ull << ctz64(r)) - 1) & su_mask : su_mask;
+			if (below >> mv[i].id & 1)
+				covered |= below & own;
+		}
+		if (max_node ? v > best : v < best)
+		{
+			best = v;
+			best_mv = mv[i];
+		}
+		if (max_node)
+			a = std::max(a, best);
+		else
+			b = std::min(b, best);
+	}
+	// a cutoff rests on the last card tried alone
+	if (a >= b)
+	{
+		rel = child_rel;
+		if (st.ord == 0)
+		{
+			killer[st.trick_id] = best_mv;
+			std::uint32_t &h = history[st.turn()][best_mv.id];
+			h = std::min(h + std::uint32_t(left * left), HISTORY_MAX);
+		}
+	}
+
+	if (bucket)
+		store(bucket, sh, ctx, st, rel, alpha, beta, best, best_mv, live);
+	return best;
+}
+
+void DoubleDummy::to_front(const RoundState &st, Card mv[], int n, Card c) const
+{
+	if (!(st.hand[st.turn()] >> c.id & 1))
+		return;
+	const std::uint64_t eq = equivalents(st, c);
+	for (int i = 0; i < n; i++)
+		if (eq >> mv[i].id & 1)
+		{
+			std::rotate(mv, mv + i, mv + i + 1);
+			return;
+		}
+}
+
+std::uint64_t DoubleDummy::rank_winner(const Card trick[Hokm::N_PLAYERS], Card win)
+{
+	for (int k = 0; k < Hokm::N_PLAYERS; k++)
+		if (trick[k] != win && trick[k].suit() == win.suit())
+			return 1ull << win.id;
+	return 0;
+}
+
+void DoubleDummy::sure_tricks(const RoundState &st, int sure[Hokm::N_TEAMS], std::uint64_t seen[Hokm::N_TEAMS])
+{
+	const std::uint64_t live = st.hand[0] | st.hand[1] | st.hand[2] | st.hand[3];
+	// the top live cards of a suit held by one seat, from the top down
+	auto top_run = [&live](std::uint64_t own, Suit su)
+	{
+		std::uint64_t run = 0;
+		for (std::uint64_t m = live & Hand::suit_mask(su); m && (own >> msb64(m) & 1); m ^= 1ull << msb64(m))
+			run |= 1ull << msb64(m);
+		return run;
+	};
+	// its top `n` cards
+	auto top_n = [](std::uint64_t run, int n)
+	{
+		for (n = popcount64(run) - n; n > 0; n--)
+			run &= run - 1;
+		return run;
+	};
+	auto len = [&st](int pl, Suit su) { return popcount64(st.hand[pl] & Hand::suit_mask(su)); };
+	// a bound rests on the cards it counts as winners
+	auto raise = [&sure, &seen](int team, int n, std::uint64_t cards)
+	{
+		if (n > sure[team])
+		{
+			sure[team] = n;
+			seen[team] = cards;
+		}
+	};
+
+	// A seat's run of top trumps takes one trick per card whenever played.
+	sure[0] = sure[1] = 0;
+	seen[0] = seen[1] = 0;
+	for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+	{
+		const std::uint64_t run = top_run(st.hand[pl], st.trump);
+		raise(pl % Hokm::N_TEAMS, popcount64(run), run);
+	}
+
+	// Seat `pl` on lead cashes its top trumps, which draws as many rounds of
+	// trumps, then its masters of each side suit as long as no opponent can
+	// ruff.
+	auto cash = [&](int pl, std::uint64_t &cards)
+	{
+		cards = top_run(st.hand[pl], st.trump);
+		const int tr_run = popcount64(cards);
+		int opp_trumps[2];
+		const int opp[2] = {(pl + 1) % Hokm::N_PLAYERS, (pl + 3) % Hokm::N_PLAYERS};
+		for (int i = 0; i < 2; i++)
+			opp_trumps[i] = std::max(0, len(opp[i], st.trump) - tr_run);
+		int n = tr_run;
+		for (Suit su = 0; su < Card::N_SUITS; su++)
+		{
+			if (su == st.trump)
+				continue;
+			const std::uint64_t run = top_run(st.hand[pl], su);
+			int k = popcount64(run);
+			for (int i = 0; i < 2; i++)
+				if (opp_trumps[i])
+					k = std::min(k, len(opp[i], su));
+			cards |= top_n(run, k);
+			n += k;
+		}
+		return n;
+	};
+	const int ld = st.leader, pd = (ld + 2) % Hokm::N_PLAYERS;
+	std::uint64_t cards;
+	int n = cash(ld, cards);
+	raise(ld % Hokm::N_TEAMS, n, cards);
+	// The leader may instead give up the lead to partner's top card of a suit
+	// it holds, if neither opponent can ruff that first round; then partner
+	// cashes.
+	for (Suit su = 0; su < Card::N_SUITS; su++)
+	{
+		if (!len(ld, su) || !top_run(st.hand[pd], su))
+			continue;
+		bool ruffed = false;
+		for (int opp : {(ld + 1) % Hokm::N_PLAYERS, (ld + 3) % Hokm::N_PLAYERS})
+			ruffed |= su != st.trump && !len(opp, su) && len(opp, st.trump);
+		if (!ruffed)
+		{
+			n = cash(pd, cards);
+			raise(ld % Hokm::N_TEAMS, n, cards | top_n(top_run(st.hand[pd], su), 1));
+			break;
+		}
+	}
+}
+
+DoubleDummy::Shape DoubleDummy::shape(const RoundState &st)
+{
+	// Cards on the table count as their seat's. Per suit, the owners of its
+	// live cards from the top down, 2 bits each from bit 25 down: the ranks
+	// themselves do not matter once the cards between them are gone.
+	std::uint64_t own[Hokm::N_PLAYERS];
+	for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+		own[pl] = st.hand[pl] | (st.table[pl] != Card::NONE ? 1ull << st.table[pl].id : 0);
+	Shape sh{0, {0, 0, 0, 0}};
+	for (Suit su = 0; su < Card::N_SUITS; su++)
+	{
+		const int sh_su = su * Card::N_RANKS;
+		std::uint64_t lane[Hokm::N_PLAYERS];
+		for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+		{
+			lane[pl] = own[pl] >> sh_su & Hand::SUIT_LANE;
+			sh.lengths |= std::uint64_t(popcount64(lane[pl])) << 4 * (su * Hokm::N_PLAYERS + pl);
+		}
+		std::uint64_t live = lane[0] | lane[1] | lane[2] | lane[3];
+		std::uint32_t seq = 0;
+		for (int pos = Card::N_RANKS - 1; live; live ^= 1ull << msb64(live), pos--)
+		{
+			const int r = msb64(live);
+			seq |= std::uint32_t(((lane[1] | lane[3]) >> r & 1) | ((lane[2] | lane[3]) >> r & 1) << 1) << 2 * pos;
+		}
+		sh.seq[su] = seq;
+	}
+	return sh;
+}
+
+std::uint32_t DoubleDummy::table_key(const RoundState &st)
+{
+	// the number of cards on the table, then each in play order as its suit
+	// and the live cards above it, table included, 6 bits a card
+	std::uint64_t live = st.hand[0] | st.hand[1] | st.hand[2] | st.hand[3];
+	for (int o = 0; o < st.ord; o++)
+		live |= 1ull << st.table[(st.leader + o) % Hokm::N_PLAYERS].id;
+	std::uint32_t k = st.ord;
+	for (int o = 0; o < st.ord; o++)
+	{
+		const Card c = st.table[(st.leader + o) % Hokm::N_PLAYERS];
+		k |= std::uint32_t(c.suit() << 4 | popcount64(live & Hand::above_mask(c.suit(), c.rank()))) << (2 + 6 * o);
+	}
+	return k;
+}
+
+bool DoubleDummy::matches(const Entry &e, const Shape &sh, std::uint32_t ctx)
+{
+	if (e.lengths != sh.lengths || e.ctx != ctx)
+		return false;
+	for (Suit su = 0; su < Card::N_SUITS; su++)
+		if ((e.seq[su] ^ sh.seq[su]) & top_bits(e.seq[su] >> SEQ_BITS))
+			return false;
+	return true;
+}
+
+std::uint64_t DoubleDummy::region(const RoundState &st, const Entry &e)
+{
+	std::uint64_t live = st.hand[0] | st.hand[1] | st.hand[2] | st.hand[3];
+	for (Card t : st.table)
+		if (t != Card::NONE)
+			live |= 1ull << t.id;
+	std::uint64_t out = 0;
+	for (Suit su = 0; su < Card::N_SUITS; su++)
+	{
+		// the top `k` live cards of the suit
+		std::uint64_t m = live & Hand::suit_mask(su);
+		for (int drop = popcount64(m) - int(e.seq[su] >> SEQ_BITS); drop > 0; drop--)
+			m &= m - 1;
+		out |= m;
+	}
+	return out;
+}
+
+void DoubleDummy::store(Entry *bucket, const Shape &sh, std::uint32_t ctx, const RoundState &st, std::uint64_t rel,
+						int alpha, int beta, int best, Card best_mv, std::uint64_t live)
+{
+	const bool max_node = st.turn() % Hokm::N_TEAMS == 0;
+	// Per suit, the live cards from the top down to the lowest relevant one
+	// are kept; the cards below it only count towards the suit lengths.
+	std::uint64_t own_live = live;
+	for (Card t : st.table)
+		if (t != Card::NONE)
+			own_live |= 1ull << t.id;
+	Entry ne{sh.lengths, {0, 0, 0, 0}, ctx, 0, static_cast<std::int8_t>(Hokm::N_TRICKS - st.trick_id), -1, 0};
+	for (Suit su = 0; su < Card::N_SUITS; su++)
+	{
+		const std::uint64_t r = rel & Hand::suit_mask(su);
+		const int k = r ? popcount64(own_live & Hand::suit_mask(su) & ~((1ull << ctz64(r)) - 1)) : 0;
+		ne.seq[su] = (sh.seq[su] & top_bits(k)) | std::uint32_t(k) << SEQ_BITS;
+	}
+
+	Entry *e = bucket;
+	while (e < bucket + WAYS && !(e->lengths == ne.lengths && e->ctx == ctx &&
+								  std::equal(e->seq, e->seq + Card::N_SUITS, ne.seq)))
+		e++;
+	if (e == bucket + WAYS)
+	{
+		// newest first, the oldest drops out
+		std::copy_backward(bucket, bucket + WAYS - 1, bucket + WAYS);
+		e = bucket;
+		*e = ne;
+	}
+	if (max_node ? best > alpha : best < beta)
+	{
+		e->best_su = static_cast<std::int8_t>(best_mv.suit());
+		e->best_pos = static_cast<std::int8_t>(popcount64(live & Hand::above_mask(best_mv.suit(), best_mv.rank())));
+	}
+	if (best > alpha)
+		e->lo = static_cast<std::int8_t>(std::max(int(e->lo), best));
+	if (best < beta)
+		e->hi = static_cast<std::int8_t>(std::min(int(e->hi), best));
+}
+
+std::uint64_t DoubleDummy::equivalents(const RoundState &st, Card c) const
+{
+	const std::uint64_t own = st.hand[st.turn()];
+	std::uint64_t live = st.hand[0] | st.hand[1] | st.hand[2] | st.hand[3];
+	for (Card t : st.table)
+		if (t != Card::NONE)
+			live |= 1ull << t.id;
+	live &= Hand::suit_mask(c.suit());
+
+	std::uint64_t eq = 1ull << c.id;
+	// walk up and down the live cards of the suit while they are ours
+	for (std::uint64_t up = live & ~((2ull << c.id) - 1); up; up &= up - 1)
+	{
+		if (!(own >> ctz64(up) & 1))
+			break;
+		eq |= up & -up;
+	}
+	for (std::uint64_t down = live & ((1ull << c.id) - 1); down; down ^= 1ull << msb64(down))
+	{
+		if (!(own >> msb64(down) & 1))
+			break;
+		eq |= 1ull << msb64(down);
+	}
+	return eq;
+}
+
+int DoubleDummy::ordered_moves(const RoundState &st, Card out[]) const
+{
+	const int pl = st.turn();
+	const int team = pl % Hokm::N_TEAMS;
+	const std::uint64_t own = st.hand[pl];
+	const std::uint64_t trumps = Hand::suit_mask(st.trump);
+	std::uint64_t live = 0;
+	int best_key = -1, best_seat = -1;
+	for (int p = 0; p < Hokm::N_PLAYERS; p++)
+	{
+		live |= st.hand[p];
+		if (st.table[p] != Card::NONE)
+		{
+			live |= 1ull << st.table[p].id;
+			const int tk = Hokm::TRICK_KEYS.key[st.led][st.trump][st.table[p].id];
+			if (tk > best_key)
+			{
+				best_key = tk;
+				best_seat = p;
+			}
+		}
+	}
+
+	// Best key each team can still add to the trick after this seat; when
+	// leading it depends on the suit, so it is worked out per card below.
+	auto top_key = [&st, &trumps](int p, Suit led)
+	{
+		const std::uint64_t h = st.hand[p];
+		const std::uint64_t follow = h & Hand::suit_mask(led);
+		const std::uint64_t m = follow ? follow : (h & trumps);
+		return m ? int(Hokm::TRICK_KEYS.key[led][st.trump][msb64(m)]) : 0;
+	};
+	auto later_max = [&](Suit led, int tm)
+	{
+		int k = 0;
+		for (int o = st.ord + 1; o < Hokm::N_PLAYERS; o++)
+		{
+			const int p = (pl + o - st.ord) % Hokm::N_PLAYERS;
+			if (p % Hokm::N_TEAMS == tm)
+				k = std::max(k, top_key(p, led));
+		}
+		return k;
+	};
+	const int opp_later = st.ord ? later_max(st.led, 1 - team) : 0;
+	const bool partner_safe = best_seat >= 0 && best_seat % Hokm::N_TEAMS == team && best_key > opp_later;
+
+	int score[Card::N_RANKS];
+	int n = 0;
+	std::uint64_t legal = st.legal();
+	while (legal)
+	{
+		// one card per run of equivalent ranks: the top one, then skip the
+		// rest of the run
+		const Cid id = msb64(legal);
+		const Card c(id);
+		const std::uint64_t suit_live = live & Hand::suit_mask(c.suit());
+		std::uint64_t run = 1ull << id;
+		for (std::uint64_t down = suit_live & ((1ull << id) - 1); down && (own >> msb64(down) & 1);
+			 down ^= 1ull << msb64(down))
+			run |= 1ull << msb64(down);
+		legal &= ~run;
+
+		int s;
+		if (st.ord == 0)
+		{
+			const Suit su = c.suit();
+			const int tk = Hokm::TRICK_KEYS.key[su][st.trump][id];
+			const int opp = later_max(su, 1 - team);
+			const int mate = std::max(later_max(su, team), tk);
+			// a class, then the history of the lead, then rank
+			int cls, sub;
+			if (tk > opp)
+				cls = 3, sub = c.rank(); // cash a sure winner
+			else if (mate > opp)
+				cls = 1, sub = 0; // to partner's winner
+			else if (opp >= 32 && su != st.trump)
+				cls = 0, sub = 12 - c.rank(); // gets ruffed
+			else
+				cls = 2, sub = 12 - c.rank(); // low, to set up or give up the lead
+			s = cls << 24 | int(history[pl][id]) << 4 | sub;
+		}
+		else
+		{
+			const int tk = Hokm::TRICK_KEYS.key[st.led][st.trump][id];
+			if (partner_safe)
+				s = -tk; // partner has it: play low
+			else if (tk > best_key && tk > opp_later)
+				s = 300 - tk; // the cheapest sure winner
+			else if (tk > best_key && (st.ord == 2 || later_max(st.led, team) <= opp_later))
+				s = 100 - tk; // take the lead for now
+			else
+				s = -tk; // follow or discard low
+		}
+
+		int i = n++;
+		for (; i > 0 && score[i - 1] < s; i--)
+		{
+			score[i] = score[i - 1];
+			out[i] = out[i - 1];
+		}
+		score[i] = s;
+		out[i] = c;
+	}
+	return n;
+}
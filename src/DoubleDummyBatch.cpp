@@ -0,0 +1,72 @@
+#include "DoubleDummyBatch.h"
+
+#include <stdexcept>
+
+#include "bits.h"
+
+DoubleDummyBatch::DoubleDummyBatch(int nbr_threads, int tt_log2) : pool(nbr_threads)
+{
+	for (unsigned w = 0; w < pool.size(); w++)
+		solvers.emplace_back(new DoubleDummy(tt_log2));
+}
+
+void DoubleDummyBatch::solve(const RoundState *positions, std::size_t n, std::array<int, Hokm::N_TEAMS> *tricks)
+{
+	pool.parallel_for(n, [&](std::size_t t, unsigned w)
+	{
+		tricks[t] = solvers[w]->solve(positions[t]);
+	});
+}
+
+std::vector<std::array<int, Hokm::N_TEAMS>> DoubleDummyBatch::solve(const std::vector<RoundState> &positions)
+{
+	std::vector<std::array<int, Hokm::N_TEAMS>> tricks(positions.size());
+	solve(positions.data(), positions.size(), tricks.data());
+	return tricks;
+}
+
+void DoubleDummyBatch::solve_tables(const std::array<std::uint64_t, Hokm::N_PLAYERS> *deals, std::size_t n,
+									TrickTable *tables)
+{
+	for (std::size_t d = 0; d < n; d++)
+	{
+		const int len = popcount64(deals[d][0]);
+		std::uint64_t seen = 0;
+		for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+		{
+			if (popcount64(deals[d][pl]) != len || len > Hokm::N_TRICKS || (deals[d][pl] & seen))
+				throw std::invalid_argument("DoubleDummyBatch::solve_tables: hands of a deal must be disjoint "
+											"and of equal length");
+			seen |= deals[d][pl];
+		}
+	}
+	// Task t is trump t % N_SUITS of deal t / N_SUITS; its four leaders run
+	// on the same worker, where they share table entries.
+	pool.parallel_for(n * Card::N_SUITS, [&](std::size_t t, unsigned w)
+	{
+		const std::size_t d = t / Card::N_SUITS;
+		const Suit trump = static_cast<Suit>(t % Card::N_SUITS);
+		for (int leader = 0; leader < Hokm::N_PLAYERS; leader++)
+		{
+			RoundState st(deals[d].data(), trump, leader);
+			// short hands are the last tricks of a round
+			st.trick_id = Hokm::N_TRICKS - popcount64(deals[d][0]);
+			tables[d].tricks[trump][leader] = solvers[w]->solve(st);
+		}
+	});
+}
+
+std::vector<DoubleDummyBatch::TrickTable> DoubleDummyBatch::solve_tables(
+	const std::vector<std::array<std::uint64_t, Hokm::N_PLAYERS>> &deals)
+{
+	std::vector<TrickTable> tables(deals.size());
+	solve_tables(deals.data(), deals.size(), tables.data());
+	return tables;
+}
+
+DoubleDummyBatch::TrickTable DoubleDummyBatch::solve_table(const std::array<std::uint64_t, Hokm::N_PLAYERS> &deal)
+{
+	TrickTable table;
+	solve_tables(&deal, 1, &table);
+	return table;
+}
@@ -0,0 +1,95 @@
+/*
+ * DoubleDummyBatch_test.cpp
+ */
+#include "DoubleDummyBatch.h"
+
+#include <iostream>
+#include <stdexcept>
+
+#include "Rng.h"
+
+namespace {
+std::array<std::uint64_t, Hokm::N_PLAYERS> random_hands(Rng &rng, int len)
+{
+	Cid ids[Card::N_CARDS];
+	for (Cid id = 0; id < Card::N_CARDS; id++)
+		ids[id] = id;
+	for (int i = Card::N_CARDS - 1; i > 0; i--)
+		std::swap(ids[i], ids[rng.below(i + 1)]);
+	std::array<std::uint64_t, Hokm::N_PLAYERS> hands{};
+	for (int i = 0; i < len * Hokm::N_PLAYERS; i++)
+		hands[i % Hokm::N_PLAYERS] |= 1ull << ids[i];
+	return hands;
+}
+}
+
+void DoubleDummyBatch_test()
+{
+	Rng rng(13);
+	DoubleDummyBatch batch(3, 18);
+	DoubleDummy dd(18);
+
+	// positions a few tricks into a round, some of them mid-trick
+	std::vector<RoundState> positions;
+	for (int i = 0; i < 12; i++)
+	{
+		auto hands = random_hands(rng, Hokm::N_TRICKS);
+		RoundState st(hands.data(), rng.below(Card::N_SUITS), rng.below(Hokm::N_PLAYERS));
+		for (int k = 3 * Hokm::N_PLAYERS + rng.below(Hokm::N_PLAYERS); k > 0; k--)
+		{
+			std::uint64_t legal = st.legal();
+			st.play(Card(select64(legal, rng.below(popcount64(legal)))));
+		}
+		positions.push_back(st);
+	}
+	int bad = 0;
+	const auto tricks = batch.solve(positions);
+	for (std::size_t i = 0; i < positions.size(); i++)
+		bad += (tricks[i] != dd.solve(positions[i]));
+
+	// trick tables of short deals
+	std::vector<std::array<std::uint64_t, Hokm::N_PLAYERS>> deals;
+	for (int i = 0; i < 4; i++)
+		deals.push_back(random_hands(rng, 7));
+	const auto tables = batch.solve_tables(deals);
+	for (std::size_t d = 0; d < deals.size(); d++)
+		for (Suit trump = 0; trump < Card::N_SUITS; trump++)
+			for (int leader = 0; leader < Hokm::N_PLAYERS; leader++)
+			{
+				RoundState st(deals[d].data(), trump, leader);
+				st.trick_id = Hokm::N_TRICKS - 7;
+				const auto &cell = tables[d].tricks[trump][leader];
+				bad += (cell != dd.solve(st) || cell[0] + cell[1] != 7);
+			}
+
+	auto rejects = [&batch](const std::array<std::uint64_t, Hokm::N_PLAYERS> &deal)
+	{
+		try
+		{
+			batch.solve_table(deal);
+		}
+		catch (const std::invalid_argument &)
+		{
+			return true;
+		}
+		return false;
+	};
+	// hand 1 swaps a card of its own for one of hand 0's: the lengths stay
+	// equal, so only the overlap is at fault
+	auto overlap = deals[0];
+	overlap[1] = (overlap[1] & (overlap[1] - 1)) | (overlap[0] & (0 - overlap[0]));
+	const bool overlap_rejected = rejects(overlap);
+	// hand 1 takes a card nobody holds
+	auto longer = deals[0];
+	longer[1] |= 1ull << ctz64(~(longer[0] | longer[1] | longer[2] | longer[3]));
+	const bool length_rejected = rejects(longer);
+
+	std::cout << "DoubleDummyBatch " << batch.size() << " workers: " << positions.size() << " positions, "
+			  << deals.size() << " trick tables, mismatches: " << bad << ", overlapping hands "
+			  << (overlap_rejected ? "rejected" : "accepted") << ", unequal hands "
+			  << (length_rejected ? "rejected" : "accepted") << std::endl;
+	if (bad)
+		throw std::runtime_error("DoubleDummyBatch_test: batch results differ from DoubleDummy");
+	if (!overlap_rejected || !length_rejected)
+		throw std::runtime_error("DoubleDummyBatch_test: malformed deal accepted");
+}
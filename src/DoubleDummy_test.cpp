@@ -0,0 +1,113 @@
+/*
+ * DoubleDummy_test.cpp
+ */
+#include "DoubleDummy.h"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#include "Rng.h"
+
+namespace {
+// Plain minimax over every legal card: team 0's tricks still to come.
+int brute_force(RoundState &st)
+{
+	if (st.done())
+		return 0;
+	const bool max_node = st.turn() % Hokm::N_TEAMS == 0;
+	int best = max_node ? -1 : Hokm::N_TRICKS + 1;
+	for (Cid id : BitIter(st.legal()))
+	{
+		const int w = st.play(Card(id));
+		const int v = (w >= 0 && w % Hokm::N_TEAMS == 0) + brute_force(st);
+		st.undo();
+		best = max_node ? std::max(best, v) : std::min(best, v);
+	}
+	return best;
+}
+
+RoundState random_deal(Rng &rng)
+{
+	Cid ids[Card::N_CARDS];
+	for (Cid id = 0; id < Card::N_CARDS; id++)
+		ids[id] = id;
+	for (int i = Card::N_CARDS - 1; i > 0; i--)
+		std::swap(ids[i], ids[rng.below(i + 1)]);
+	std::uint64_t hands[Hokm::N_PLAYERS] = {0};
+	for (int i = 0; i < Card::N_CARDS; i++)
+		hands[i % Hokm::N_PLAYERS] |= 1ull << ids[i];
+	return RoundState(hands, rng.below(Card::N_SUITS), rng.below(Hokm::N_PLAYERS));
+}
+
+void random_plays(RoundState &st, Rng &rng, int n)
+{
+	for (; n > 0; n--)
+	{
+		std::uint64_t legal = st.legal();
+		st.play(Card(select64(legal, rng.below(popcount64(legal)))));
+	}
+}
+}
+
+void DoubleDummy_test()
+{
+	Rng rng(12);
+	DoubleDummy dd;
+
+	// endgames of 3 to 4 tricks, some mid-trick, against brute force
+	int bad = 0;
+	const int nbr_endgames = 300;
+	for (int g = 0; g < nbr_endgames; g++)
+	{
+		RoundState st = random_deal(rng);
+		random_plays(st, rng, 9 * Hokm::N_PLAYERS + rng.below(Hokm::N_PLAYERS + 1));
+		const int left = Hokm::N_TRICKS - st.trick_id;
+		const int ref = brute_force(st);
+		const auto tr = dd.solve(st);
+		bad += (tr[0] != st.team_scores[0] + ref || tr[1] != st.team_scores[1] + left - ref);
+
+		Card cards[Card::N_RANKS];
+		int tricks[Card::N_RANKS];
+		const int n = dd.solve_moves(st, cards, tricks);
+		const int team = st.turn() % Hokm::N_TEAMS;
+		int best = -1;
+		for (int i = 0; i < n; i++)
+		{
+			const int w = st.play(cards[i]);
+			const int v = (w >= 0 && w % Hokm::N_TEAMS == 0) + brute_force(st);
+			st.undo();
+			const int got = st.team_scores[team] + (team == 0 ? v : left - v);
+			bad += (tricks[i] != got);
+			best = std::max(best, tricks[i]);
+		}
+		bad += (best != tr[team]);
+	}
+	std::cout << "DoubleDummy endgames checked: " << nbr_endgames << ", mismatches: " << bad << std::endl;
+	if (bad)
+		throw std::runtime_error("DoubleDummy_test: solver disagrees with brute force");
+
+	// full deals against a search budget: every deal and the average must
+	// solve within it; nodes rather than time, so the check does not hang
+	// on the machine
+	const int nbr_deals = 8;
+	const std::uint64_t max_nodes = 2000000, avg_nodes = 500000;
+	std::uint64_t nodes = 0, worst_nodes = 0;
+	double total_ms = 0;
+	for (int d = 0; d < nbr_deals; d++)
+	{
+		const RoundState st = random_deal(rng);
+		dd.clear();
+		const auto t0 = std::chrono::steady_clock::now();
+		const auto tr = dd.solve(st);
+		total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+		nodes += dd.nodes();
+		worst_nodes = std::max(worst_nodes, dd.nodes());
+		if (tr[0] + tr[1] != Hokm::N_TRICKS || tr[0] < 0 || tr[1] < 0)
+			throw std::runtime_error("DoubleDummy_test: bad trick counts");
+	}
+	std::cout << "DoubleDummy 13-trick deals: " << nodes / nbr_deals << " nodes average, " << worst_nodes
+			  << " worst, " << total_ms / nbr_deals << " ms average" << std::endl;
+	if (worst_nodes > max_nodes || nodes / nbr_deals > avg_nodes)
+		throw std::runtime_error("DoubleDummy_test: full deals over the search budget");
+}
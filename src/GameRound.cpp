@@ -2,7 +2,6 @@
 
 #include <chrono>
 #include <iostream>
-#include <random>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -12,15 +11,19 @@
 #include "Deck.h"
 #include "GameConfig.h"
 #include "Hand.h"
+#include "Trick.h"
 #include "table.h"
 #include "utils.h"
 
-GameRound::GameRound(std::array<Agent *, Hokm::N_PLAYERS> agent)
+GameRound::GameRound(std::array<Agent *, Hokm::N_PLAYERS> agent, Rng rng)
     : round_id(-1), hist(), deck(), agent(agent), team_scores({0}),
-      mt_rnd_gen(std::mt19937(std::random_device()())), winner_team(-1),
+      rng(rng), winner_team(-1),
       trump_team(-1), opening_player(-1), kot(0) {
 
+  // Seats follow the table; agents already seated there keep their names.
   for (int i = 0; i < Hokm::N_PLAYERS; i++) {
+    if (agent[i]->get_id() != i)
+      agent[i]->set_seat(i);
     name[i] = agent[i]->get_name();
   }
 }
@@ -29,9 +32,8 @@ void GameRound::reset() {
   round_id++;
   state.reset();
   hist.reset();
-  std::uniform_int_distribution<int> four_rnd(0, 3);
   if (winner_team == -1) {
-    opening_player = four_rnd(mt_rnd_gen);
+    opening_player = rng.below(Hokm::N_PLAYERS);
   } else if (winner_team != trump_team) {
     opening_player = (opening_player + 1) % Hokm::N_PLAYERS;
   }
@@ -42,9 +44,9 @@ void GameRound::reset() {
     deck = Deck(collect);
     collect.clear();
   }
-  deck.shuffle_deal(stack.data(), opening_player, Hokm::SHUFFLE_CMPLX);
+  deck.shuffle_deal(rng, stack.data(), opening_player, Hokm::SHUFFLE_CMPLX);
   LOG("deck after shuffle: " << deck.to_cardStack().to_string());
-  // stack[state.turn].shuffle();
+  // stack[state.turn].shuffle(rng);
   state.trump = -1;
   team_scores.fill(0);
   state.led = Card::NON_SU;
@@ -64,6 +66,58 @@ void GameRound::deal_n_init() {
   }
 }
 
+RoundSnapshot GameRound::capture() const {
+  RoundSnapshot snap;
+  for (int pl = 0; pl < Hokm::N_PLAYERS; pl++) {
+    snap.hand[pl] = hand[pl].bin64;
+    snap.table[pl] = state.table[pl];
+  }
+  int nbr_tricks = hist.played_cards[0].get_nbr_cards();
+  for (int t = 0; t < Hokm::N_TRICKS; t++)
+    for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+      snap.plays[t][pl] = (t < nbr_tricks) ? hist.played_cards[pl].at(t) : Card::NONE;
+  snap.trump = state.trump;
+  snap.led = state.led;
+  snap.turn = state.turn;
+  snap.ord = state.ord;
+  snap.trick_id = state.trick_id;
+  snap.nbr_tricks = nbr_tricks;
+  for (int team = 0; team < Hokm::N_TEAMS; team++)
+    snap.team_scores[team] = team_scores[team];
+  snap.opening_player = opening_player;
+  snap.trump_team = trump_team;
+  snap.winner_team = winner_team;
+  snap.kot = kot;
+  snap.round_id = round_id;
+  return snap;
+}
+
+void GameRound::restore(const RoundSnapshot &snap) {
+  hist.reset();
+  collect.clear();
+  for (int t = 0; t < snap.nbr_tricks; t++)
+    for (int pl = 0; pl < Hokm::N_PLAYERS; pl++) {
+      hist.played_cards[pl].append(snap.plays[t][pl]);
+      collect.append(snap.plays[t][pl]);
+    }
+  for (int pl = 0; pl < Hokm::N_PLAYERS; pl++) {
+    hand[pl] = Hand(snap.hand[pl]);
+    state.table[pl] = snap.table[pl];
+  }
+  state.trump = snap.trump;
+  state.led = snap.led;
+  state.turn = snap.turn;
+  state.ord = snap.ord;
+  state.trick_id = snap.trick_id;
+  for (int team = 0; team < Hokm::N_TEAMS; team++)
+    team_scores[team] = snap.team_scores[team];
+  opening_player = snap.opening_player;
+  trump_team = snap.trump_team;
+  winner_team = snap.winner_team;
+  kot = snap.kot;
+  round_id = snap.round_id;
+}
+
 void GameRound::broadcast_info(std::string info_str, int exclude) {
   if (!show_info)
     return;
@@ -72,130 +126,66 @@ void GameRound::broadcast_info(std::string info_str, int exclude) {
       agent[l]->info(info_str);
 }
 
-inline int GameRound::trick() {
-  state.reset();
-  LOG("+++ Trick id " << (int)state.trick_id << " turn " << (int)state.turn
-                      << " trump " << Card::SU_STR[state.trump] << " +++");
-  broadcast_info("/INF--- Trick " + std::to_string(state.trick_id + 1) +
-                 " ---");
-
-  for (int ord = 0; ord < Hokm::N_PLAYERS; ord++) {
-    int pl = (state.turn + ord) % Hokm::N_PLAYERS;
-    state.ord = ord;
-
-    auto ag = agent[pl];
-    std::string nameId =
-        ag->get_name(); // + " (id: " + std::to_string(ag->get_id()) + ")";
-
-    broadcast_info("/ALRWaiting for " + nameId + " to play...");
-
-    Card c = agent[pl]->act(state, hist);
-
-    LOG(">>> " + agent[pl]->get_name() + " played " + c.to_string());
-    broadcast_info("/ALR");
-    broadcast_info("/INF" + nameId + " played " + c.to_string());
-    if (show_info)
-      agent[pl]->info("/HND" + agent[pl]->get_hand().to_string());
-
-#ifdef DEBUG
-    if (!hand[pl].card_is_valid_move(c, state.led)) {
-      LOG("Game::trick: Card " + c.to_string() + " is not a valid act for " +
-          agent[pl]->get_name() + " while led: " + Card::SU_STR[state.led] +
-          ", hand: " + hand[pl].to_string());
-      throw std::runtime_error("Illegal card played");
-    }
-#endif
-
-    if (ord == 0)
-      state.led = c.su;
-    state.table[pl] = c;
-    hand[pl].remove(c);
+struct GameRound::InfoBroadcaster {
+  GameRound &g;
 
-    broadcast_info("/TBL" + table_str_with_names(state.table, name));
-    if (show_info)
-      std::this_thread::sleep_for(std::chrono::milliseconds(turn_sleep_ms));
+  void sleep(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
   }
 
-  Card best_card = state.table[0];
-  int best_pl = 0;
-  for (int pl = 1; pl < Hokm::N_PLAYERS; pl++)
-    if (Card::cmp(state.table[pl], best_card, state.led, state.trump) > 0) {
-      best_card = state.table[pl];
-      best_pl = pl;
-    }
-
-  for (int pl = 0; pl < Hokm::N_PLAYERS; pl++) {
-    collect.append(state.table[pl]);
-    hist.played_cards[pl].append(state.table[pl]);
-    LOG(agent[pl]->get_name()
-        << " played " << hist.played_cards[pl].at(-1).to_string());
+  void round_start(int round_id) {
+    g.broadcast_info("/INF=== Round " + std::to_string(round_id + 1) + " ===");
   }
 
-  LOG("^^^ Trick id " << (int)state.trick_id << " turn " << (int)state.turn
-                      << " led " << Card::SU_STR[state.led] << " trump "
-                      << Card::SU_STR[state.trump] << " ^^^");
-
-  return best_pl;
-}
-
-int GameRound::play(int round_win_score) {
-  broadcast_info("/INF=== Round " + std::to_string(round_id + 1) + " ===");
-  kot = 0;
-  for (int trick_id = 0; trick_id < Hokm::N_TRICKS; trick_id++) {
-    state.trick_id = trick_id;
-#ifdef DEBUG
-    for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
-      LOG(agent[pl]->get_name()
-          << " hand " << agent[pl]->get_hand().to_string());
-    LOG("=== Round " << round_id << ", Trick " << trick_id
-                     << ", Turn: " << (int)state.turn
-                     << ", Trump: " << Card::SU_STR[state.trump]);
-#endif
+  void trick_start(const State &st) {
+    g.broadcast_info("/INF--- Trick " + std::to_string(st.trick_id + 1) +
+                     " ---");
+  }
 
-    int trick_taker = trick();
+  void awaiting_card(int pl) {
+    g.broadcast_info("/ALRWaiting for " + g.agent[pl]->get_name() +
+                     " to play...");
+  }
 
-    int trick_taker_team = trick_taker % Hokm::N_TEAMS;
-    team_scores[trick_taker_team]++;
-    state.turn = trick_taker;
+  void card_played(int pl, const Card &c, const State &st) {
+    g.broadcast_info("/ALR");
+    g.broadcast_info("/INF" + g.agent[pl]->get_name() + " played " +
+                     c.to_string());
+    g.agent[pl]->info("/HND" + g.agent[pl]->get_hand().to_string());
+    g.broadcast_info("/TBL" + table_str_with_names(st.table, g.name));
+    sleep(g.turn_sleep_ms);
+  }
 
-    for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
-      agent[pl]->trick_result(state, team_scores);
-
-    bool round_finished = false;
-    for (int team = 0; team < Hokm::N_TEAMS; team++)
-      if (team_scores[team] >= round_win_score) {
-        round_finished = true;
-        winner_team = team;
-        break;
-      }
-
-    {
-      broadcast_info("/RSC" + std::to_string(team_scores[0]) + ":" +
-                     std::to_string(team_scores[1]));
-      broadcast_info("/INFLast table: " + table_str_with_names(state.table, name));
-      if (show_info)
-        std::this_thread::sleep_for(std::chrono::milliseconds(rnd_sleep_ms));
-      table_clear(state.table);
-      broadcast_info("/TBL" + table_str_with_names(state.table, name));
-      if (round_finished)
-        broadcast_info("/HND");
-    }
+  void trick_won(int, const State &st,
+                 const std::array<int, Hokm::N_TEAMS> &scores,
+                 bool round_finished) {
+    g.broadcast_info("/RSC" + std::to_string(scores[0]) + ":" +
+                     std::to_string(scores[1]));
+    g.broadcast_info("/INFLast table: " + table_str_with_names(st.table, g.name));
+    sleep(g.rnd_sleep_ms);
+    Card cleared[Hokm::N_PLAYERS];
+    g.broadcast_info("/TBL" + table_str_with_names(cleared, g.name));
+    if (round_finished)
+      g.broadcast_info("/HND");
+  }
 
-    if (round_finished) {
-      int oth_scr = 0;
-      for (int team = 0; team < Hokm::N_TEAMS; team++)
-        if (team != winner_team)
-          oth_scr += team_scores[team];
-      kot = (int)(oth_scr == 0) +
-            (int)((oth_scr == 0) && (winner_team != trump_team));
-      LOG("kot: " << kot << ", oth_scr: " << oth_scr << ", winner_team: "
-                  << winner_team << ", trump_team: " << trump_team);
-      break;
-    }
-  } // trick_id
+  void round_over(int, int, const std::array<int, Hokm::N_TEAMS> &) {}
+};
 
-  for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
-    collect.append(hand[pl]);
+int GameRound::trick() {
+  if (show_info) {
+    InfoBroadcaster obs{*this};
+    return trick(obs);
+  }
+  NullObserver obs;
+  return trick(obs);
+}
 
-  return winner_team;
+int GameRound::play(int round_win_score) {
+  if (show_info) {
+    InfoBroadcaster obs{*this};
+    return play(obs, round_win_score);
+  }
+  NullObserver obs;
+  return play(obs, round_win_score);
 }
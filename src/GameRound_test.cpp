@@ -0,0 +1,136 @@
+/*
+ * GameRound_test.cpp
+ */
+#include "GameRound.h"
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include "RndAgent.h"
+#include "RoundState.h"
+
+namespace {
+struct CountingObserver : NullObserver {
+	int cards = 0, tricks = 0, rounds = 0, last_winner = -1;
+	void card_played(int, const Card &, const State &) { cards++; }
+	void trick_won(int, const State &, const std::array<int, Hokm::N_TEAMS> &, bool) { tricks++; }
+	void round_over(int winner_team, int, const std::array<int, Hokm::N_TEAMS> &)
+	{
+		rounds++;
+		last_winner = winner_team;
+	}
+};
+
+struct SnapshotObserver : NullObserver {
+	GameRound *round;
+	int at_trick;
+	RoundSnapshot snap{};
+	bool taken = false;
+	// mid-trick, after the card of order at_ord when at_ord >= 0
+	int at_ord = -1;
+	void card_played(int, const Card &, const State &st)
+	{
+		if (!taken && at_ord >= 0 && st.trick_id == at_trick && st.ord == at_ord)
+		{
+			snap = round->capture();
+			taken = true;
+		}
+	}
+	void trick_won(int, const State &st, const std::array<int, Hokm::N_TEAMS> &, bool)
+	{
+		if (!taken && at_ord < 0 && st.trick_id == at_trick)
+		{
+			snap = round->capture();
+			taken = true;
+		}
+	}
+};
+}
+
+void GameRound_test()
+{
+	RndAgent ag[Hokm::N_PLAYERS] = {RndAgent(Rng(1, 0)), RndAgent(Rng(1, 1)), RndAgent(Rng(1, 2)), RndAgent(Rng(1, 3))};
+	GameRound round({&ag[0], &ag[1], &ag[2], &ag[3]}, Rng(1));
+	CountingObserver obs;
+	int wins[Hokm::N_TEAMS] = {0};
+	const int n = 20;
+	for (int r = 0; r < n; r++)
+	{
+		round.reset();
+		round.deal_n_init();
+		round.trump_call();
+		int winner = round.play(obs);
+		wins[winner]++;
+		if (winner != obs.last_winner)
+			throw std::runtime_error("GameRound_test: round_over reports a different winner");
+	}
+	std::cout << "headless rounds: " << obs.rounds << ", tricks: " << obs.tricks << ", cards: " << obs.cards
+			  << ", team wins " << wins[0] << ":" << wins[1] << std::endl;
+	if (obs.rounds != n || obs.cards != Hokm::N_PLAYERS * obs.tricks)
+		throw std::runtime_error("GameRound_test: inconsistent observer events");
+
+	// A snapshot taken mid-round restores into another table bit for bit.
+	SnapshotObserver snap_obs;
+	snap_obs.round = &round;
+	snap_obs.at_trick = 4;
+	round.reset();
+	round.deal_n_init();
+	round.trump_call();
+	round.play(snap_obs);
+	RndAgent ag2[Hokm::N_PLAYERS];
+	GameRound other({&ag2[0], &ag2[1], &ag2[2], &ag2[3]}, Rng(2));
+	other.restore(snap_obs.snap);
+	RoundSnapshot again = other.capture();
+	int held = 0;
+	for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+		held += other.get_player_hand(pl).nbr_cards();
+	std::cout << "RoundSnapshot: " << sizeof(RoundSnapshot) << " bytes, taken after trick "
+			  << (int)snap_obs.snap.trick_id << ", " << held << " cards held, scores "
+			  << other.get_hand_scores()[0] << ":" << other.get_hand_scores()[1] << std::endl;
+	if (!snap_obs.taken || std::memcmp(&again, &snap_obs.snap, sizeof(RoundSnapshot)) != 0)
+		throw std::runtime_error("GameRound_test: capture/restore round trip differs");
+
+	RoundState rs(snap_obs.snap);
+	if (rs.trick_id != snap_obs.at_trick + 1 || rs.ord != 0 || rs.leader != snap_obs.snap.turn ||
+		std::memcmp(rs.hand, snap_obs.snap.hand, sizeof(rs.hand)) != 0)
+		throw std::runtime_error("GameRound_test: RoundState from snapshot differs");
+
+	// A round restored mid-trick plays on to its end, the same way each time
+	// for the same agents.
+	SnapshotObserver mid_obs;
+	mid_obs.round = &round;
+	mid_obs.at_trick = 5;
+	mid_obs.at_ord = 1;
+	round.reset();
+	round.deal_n_init();
+	round.trump_call();
+	round.play(mid_obs);
+	if (!mid_obs.taken)
+		throw std::runtime_error("GameRound_test: no mid-trick snapshot");
+	const RoundSnapshot &mid = mid_obs.snap;
+	int results[2][Hokm::N_TEAMS + 1];
+	for (int k = 0; k < 2; k++)
+	{
+		RndAgent ag3[Hokm::N_PLAYERS] = {RndAgent(Rng(3, 0)), RndAgent(Rng(3, 1)), RndAgent(Rng(3, 2)),
+										 RndAgent(Rng(3, 3))};
+		GameRound resumed({&ag3[0], &ag3[1], &ag3[2], &ag3[3]}, Rng(3));
+		resumed.restore(mid);
+		for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+			ag3[pl].init_round(Hand(mid.hand[pl]));
+		CountingObserver counts;
+		const int winner = resumed.play(counts);
+		const std::array<int, Hokm::N_TEAMS> &scores = resumed.get_hand_scores();
+		// the two cards on the table finish the snapshot's trick
+		const int tricks = scores[0] + scores[1] - mid.team_scores[0] - mid.team_scores[1];
+		if (winner < 0 || scores[winner] != Hokm::RND_WIN_SCORE || counts.tricks != tricks ||
+			counts.cards != Hokm::N_PLAYERS * tricks - 2 || scores[0] < mid.team_scores[0] ||
+			scores[1] < mid.team_scores[1])
+			throw std::runtime_error("GameRound_test: restored round did not play on from the snapshot");
+		results[k][0] = winner;
+		results[k][1] = scores[0];
+		results[k][2] = scores[1];
+	}
+	if (std::memcmp(results[0], results[1], sizeof(results[0])) != 0)
+		throw std::runtime_error("GameRound_test: restored rounds differ");
+}
@@ -7,70 +7,42 @@
 #include "Hand.h"
 
 #include <cassert>
-#include <cstdlib>
-#include <cstring>
+#include <stdexcept>
 
 #include "utils.h"
 
-Hand::Hand() : bin64(0), nbr_cards(0) { memset(len, 0, sizeof(len)); }
+Hand::Hand() : bin64(0) {}
 
 const Hand Hand::EMPTY = Hand();
 
-Hand::Hand(const Card *cards, int nbr_cards) : bin64(0), nbr_cards(0) {
-  memset(len, 0, sizeof(len));
+Hand::Hand(const Card *cards, int nbr_cards) : bin64(0) {
   add(cards, nbr_cards);
 }
 
-Hand::Hand(std::uint64_t bin64) : bin64(0), nbr_cards(0) {
-  memset(len, 0, sizeof(len));
-  uint64_t mask = ~0ull << (64 - Card::N_CARDS) >> (64 - Card::N_CARDS);
-  bin64 &= mask;
-
-  for (Cid id = 0; id < Card::N_CARDS; id++)
-    if (bin64 & (1ull << id)) {
-      Card c = Card(id);
-      add(c);
-    }
-}
+Hand::Hand(std::uint64_t bin64) : bin64(bin64 & ALL_MASK) {}
 
 Hand &Hand::add(const Card &c) {
 #ifdef DEBUG
   if (c == Card::NONE)
     throw std::invalid_argument("Hand::add(c) : Card::NONE can't be added.");
-  if (len[c.su] == Card::N_RANKS) {
-    print_arr(cards[c.su], len[c.su], true);
-    throw std::invalid_argument("Hand::add(c) : Suit array is full. : " +
-                                c.to_string());
-  }
 #endif
-  if (sorted_unique_insert<Rank>(cards[c.su], len[c.su], c.rnk)) {
-    len[c.su]++;
-    bin64 |= 1ull << c.id;
-    nbr_cards++;
-  }
+  bin64 |= 1ull << c.id;
   return *this;
 }
 
+// ord-th lowest card of the suit
 Card Hand::pop(Suit su, int ord) {
 #ifdef DEBUG
-  if (su >= Card::N_SUITS || ord >= len[su])
+  if (su >= Card::N_SUITS || ord >= len(su))
     throw std::invalid_argument("Hand::pop : Out of bound index.");
 #endif
-  Card out = Card(su, cards[su][ord]);
-  move<Rank>(cards[su], len[su], ord + 1, -1);
-  len[su]--;
-  bin64 ^= 1ull << out.id;
-  nbr_cards--;
-  return out;
+  Cid id = select64(bin64 & suit_mask(su), ord);
+  bin64 ^= 1ull << id;
+  return Card(id);
 }
 
 Hand Hand::pop(Suit su) {
-  Hand h = Hand();
-  Card c;
-  for (int i = 0; i < len[su]; i++) {
-    c.set(su, cards[su][i]);
-    h.add(c);
-  }
+  Hand h = sub_hand(su);
   discard(su);
   return h;
 }
@@ -89,48 +61,36 @@ Hand &Hand::add(const Card *cards, int nbr_cards) {
 }
 
 Hand &Hand::add(const Hand &hand) {
-  for (Suit s = 0; s < Card::N_SUITS; s++)
-    for (uint8_t i = 0; i < hand.len[s]; i++)
-      add({s, hand.cards[s][i]});
+  bin64 |= hand.bin64;
   return *this;
 }
 
 bool Hand::remove(const Card &c) {
-  // #ifdef DEBUG
-  //	if (c == Card::NONE)
-  //		throw std::invalid_argument("Hand::remove : NONE.");
-  // #endif
-  int i = bisect<Rank>(cards[c.su], len[c.su], c.rnk);
-  if (i < 1 || cards[c.su][i - 1] != c.rnk)
+  if (c.id >= Card::N_CARDS || !(bin64 & (1ull << c.id)))
     return false;
-  move<Rank>(cards[c.su], len[c.su], i, -1);
-  bin64 &= ~(1ull << c.id);
-  len[c.su]--;
-  nbr_cards--;
+  bin64 ^= 1ull << c.id;
   return true;
 }
 
 Hand &Hand::rm_top(Suit su, int n) {
-  len[su] = (len[su] >= n) ? len[su] - n : 0;
-  return *this;
-}
-
-Hand &Hand::restore_top(Suit su, int n) {
-  len[su] = (len[su] + n <= Card::N_RANKS) ? len[su] + n : Card::N_RANKS;
+  std::uint64_t m = bin64 & suit_mask(su);
+  for (; n > 0 && m; n--)
+    m ^= 1ull << msb64(m);
+  bin64 = (bin64 & ~suit_mask(su)) | m;
   return *this;
 }
 
 std::string Hand::to_string() const {
   std::string out = "";
   for (int s = 0; s < Card::N_SUITS; s++) {
-    for (int i = 0; i < len[s]; i++) {
+    for (std::uint64_t m = bin64 & suit_mask(s); m; m &= m - 1) {
       std::string ap = " ";
-      if (i + 1 == len[s]) {
+      if (!(m & (m - 1))) {
         ap = ",";
         if (s + 1 == Card::N_SUITS)
           ap = "";
       }
-      out += Card(s, cards[s][i]).to_string() + ap;
+      out += Card(ctz64(m)).to_string() + ap;
     }
   }
   return out;
@@ -138,279 +98,183 @@ std::string Hand::to_string() const {
 
 std::string Hand::to_su_string() const {
   std::string out;
-  Card c;
   for (int s = 0; s < Card::N_SUITS; s++) {
     out += Card::SU_STR[s] + ": ";
-    for (int i = 0; i < len[s]; i++) {
-      c.set(s, cards[s][i]);
-      out += Card::RNK_STR[cards[s][i]] + " ";
-    }
+    for (Cid id : BitIter(bin64 & suit_mask(s)))
+      out += Card::RNK_STR[Card(id).rank()] + " ";
     out += (s + 1 != Card::N_SUITS) ? "\n" : "";
   }
   return out;
 }
 
 Hand &Hand::clear() {
-  memset(len, 0, sizeof(len));
   bin64 = 0;
-  nbr_cards = 0;
   return *this;
 }
 
-Hand Hand::cmpl() const {
-  return Hand(~bin64); // it will be automatically masked (to 52 cards) in the
-                       // Hand(bin64) constructor.
-}
-
-Hand Hand::uni(const Hand &rhs) const { return Hand(bin64 | rhs.bin64); }
-
-Hand Hand::inter(const Hand &rhs) const { return Hand(bin64 & rhs.bin64); }
-
 Hand Hand::gt_c_led(const Card &card, Suit led, Suit trump) const {
   assert(trump != Card::NON_SU);
-  led = (led != Card::NON_SU) ? led : card.su;
-  if (card.su == led) {
-    if (len[led] != 0) {
-      uint8_t i = bisect<Rank>(cards[led], len[led], card.rnk);
-      Hand out = Hand::EMPTY;
-      for (uint8_t j = i; j < len[led]; j++)
-        out.add(Card(led, cards[led][j]));
-      return out;
-    } else {
-      return sub_hand(trump);
-    }
+  led = (led != Card::NON_SU) ? led : card.suit();
+  if (card.suit() == led) {
+    if (len(led) != 0)
+      return Hand(bin64 & above_mask(led, card.rank()));
+    return sub_hand(trump);
   }
-  // card.su != led
-  if (len[led] != 0) {
-    if (card.su != trump)
+  // card.suit() != led
+  if (len(led) != 0) {
+    if (card.suit() != trump)
       return sub_hand(led);
     return Hand::EMPTY;
   }
-  // len[led] == 0
-  if (card.su != trump)
+  // len(led) == 0
+  if (card.suit() != trump)
     return sub_hand(trump);
-  // card.su == trump
-  uint8_t i = bisect<Rank>(cards[trump], len[trump], card.rnk);
-  Hand out = Hand::EMPTY;
-  for (uint8_t j = i; j < len[trump]; j++)
-    out.add(Card(trump, cards[trump][j]));
-  return out;
+  // card.suit() == trump
+  return Hand(bin64 & above_mask(trump, card.rank()));
 }
 
 Hand Hand::lead_gt(const Card &card, Suit led, Suit trump) const {
   assert(trump != Card::NON_SU);
-  if (led != Card::NON_SU) {
-    if (card.su == led) {
-      if (len[led] != 0) {
-        uint8_t i = bisect<Rank>(cards[led], len[led], card.rnk);
-        Hand out = Hand::EMPTY;
-        for (uint8_t j = i; j < len[led]; j++)
-          out.add(Card(led, cards[led][j]));
-        return out;
-      } else
-        return sub_hand(trump);
-    }
-    // card.su != led
-    if (len[led] != 0) {
-      if (card.su != trump)
-        return sub_hand(led);
-      return Hand::EMPTY;
-    }
-    // len[led] == 0
-    if (card.su != trump)
-      return sub_hand(trump);
-    // card.su == trump
-    uint8_t i = bisect<Rank>(cards[trump], len[trump], card.rnk);
-    Hand out = Hand::EMPTY;
-    for (uint8_t j = i; j < len[trump]; j++)
-      out.add(Card(trump, cards[trump][j]));
-    return out;
-  }
+  if (led != Card::NON_SU)
+    return gt_c_led(card, led, trump);
   // led == Non
-  if (card.su == trump) {
-    uint8_t i = bisect<Rank>(cards[trump], len[trump], card.rnk);
-    Hand out = Hand::EMPTY;
-    for (uint8_t j = i; j < len[trump]; j++)
-      out.add(Card(trump, cards[trump][j]));
-    return out;
-  }
-  // card.su != trump
-  Hand out = *this;
-  out.discard(card.su);
-  uint8_t i = bisect<Rank>(cards[card.su], len[card.su], card.rnk);
-  for (uint8_t j = i; j < len[card.su]; j++)
-    out.add(Card(card.su, cards[card.su][j]));
-  return out;
+  if (card.suit() == trump)
+    return Hand(bin64 & above_mask(trump, card.rank()));
+  // card.suit() != trump
+  return Hand((bin64 & ~suit_mask(card.suit())) |
+              (bin64 & above_mask(card.suit(), card.rank())));
 }
 
 // if led is non, `this` suit gonna be lead
 Hand Hand::lead_gt(const Hand &hand, Suit led, Suit trump) const {
-  Hand out;
+  std::uint64_t out = 0;
   if (led == Card::NON_SU) {
     for (Suit s = 0; s < Card::N_SUITS; s++) {
-      if (len[s] == 0)
-        continue;
-      if (hand.len[s] == 0) {
-        if (hand.len[trump] == 0) {
-          out.add(sub_hand(s));
-        }
+      std::uint64_t h_s = hand.bin64 & suit_mask(s);
+      if (h_s == 0) {
+        if (hand.len(trump) == 0)
+          out |= bin64 & suit_mask(s);
       } else {
-        uint8_t i =
-            bisect<Rank>(cards[s], len[s], hand.cards[s][hand.len[s] - 1]);
-        for (uint8_t j = i; j < len[s]; j++)
-          out.add(Card(s, cards[s][j]));
+        out |= bin64 & above_mask(s, msb64(h_s) - s * Card::N_RANKS);
       }
     }
-    return out;
+    return Hand(out);
   }
 
   // led not non
-  if (hand.len[led] != 0) {
-    if (len[led] != 0) {
-      uint8_t i = bisect<Rank>(cards[led], len[led],
-                               hand.cards[led][hand.len[led] - 1]);
-      for (uint8_t j = i; j < len[led]; j++)
-        out.add(Card(led, cards[led][j]));
-    } else {
-      out.add(sub_hand(trump));
-    }
-    return out;
+  std::uint64_t h_led = hand.bin64 & suit_mask(led);
+  if (h_led != 0) {
+    if (len(led) != 0)
+      out = bin64 & above_mask(led, msb64(h_led) - led * Card::N_RANKS);
+    else
+      out = bin64 & suit_mask(trump);
+    return Hand(out);
   }
 
-  // hand.len[led] == 0
-  if (hand.len[trump] == 0)
-    if (len[led] != 0)
-      out.add(sub_hand(led));
-    else
-      out.add(sub_hand(trump));
-  else // hand.len[trump] != 0
-    if (len[led] == 0 && len[trump] != 0) {
-      uint8_t i = bisect<Rank>(cards[trump], len[trump],
-                               hand.cards[trump][hand.len[trump] - 1]);
-      for (uint8_t j = i; j < len[trump]; j++)
-        out.add(Card(trump, cards[trump][j]));
-    }
-  return out;
+  // hand.len(led) == 0
+  std::uint64_t h_tr = hand.bin64 & suit_mask(trump);
+  if (h_tr == 0)
+    out = bin64 & suit_mask((len(led) != 0) ? led : trump);
+  else if (len(led) == 0)
+    out = bin64 & above_mask(trump, msb64(h_tr) - trump * Card::N_RANKS);
+  return Hand(out);
 }
 
 Hand Hand::gt_h_lead(const Hand &hand, Suit led, Suit trump) const {
+  if (led != Card::NON_SU)
+    return lead_gt(hand, led, trump);
 
-  Hand out;
-  if (led == Card::NON_SU) {
-    for (Suit s = 0; s < Card::N_SUITS; s++) {
-      if (hand.len[s] != 0) {
-        if (len[s] != 0) {
-          uint8_t i =
-              bisect<Rank>(cards[s], len[s], hand.cards[s][hand.len[s] - 1]);
-          for (uint8_t j = i; j < len[s]; j++)
-            out.add(Card(s, cards[s][j]));
-        } else {
-          out.add(sub_hand(trump));
-        }
-      }
-    }
-  } else { // led not non
-    if (hand.len[led] != 0) {
-      if (len[led] != 0) {
-        uint8_t i = bisect<Rank>(cards[led], len[led],
-                                 hand.cards[led][hand.len[led] - 1]);
-        for (uint8_t j = i; j < len[led]; j++)
-          out.add(Card(led, cards[led][j]));
-      } else {
-        out.add(sub_hand(trump));
-      }
-    } else // hand.len[led] == 0
-    {
-      if (hand.len[trump] == 0)
-        if (len[led] != 0)
-          out.add(sub_hand(led));
-        else
-          out.add(sub_hand(trump));
-      else // hand.len[trump] != 0
-        if (len[led] == 0 && len[trump] != 0) {
-          uint8_t i = bisect<Rank>(cards[trump], len[trump],
-                                   hand.cards[trump][hand.len[trump] - 1]);
-          for (uint8_t j = i; j < len[trump]; j++)
-            out.add(Card(trump, cards[trump][j]));
-        }
-    }
+  std::uint64_t out = 0;
+  for (Suit s = 0; s < Card::N_SUITS; s++) {
+    std::uint64_t h_s = hand.bin64 & suit_mask(s);
+    if (h_s == 0)
+      continue;
+    if (len(s) != 0)
+      out |= bin64 & above_mask(s, msb64(h_s) - s * Card::N_RANKS);
+    else
+      out |= bin64 & suit_mask(trump);
   }
-  return out;
+  return Hand(out);
 }
 
 // hand > card
 Hand Hand::gt(const Card &card, Suit led, Suit trump) const {
-  Hand out = Hand::EMPTY;
-  Card c;
-  for (Suit s = 0; s < Card::N_SUITS; s++) {
-    for (int i = 0; i < len[s]; i++) {
-      c.set(s, cards[s][i]);
-      if (Card::cmp(c, card, led, trump) > 0)
-        out.add(c);
-    }
+  if (card == Card::NONE)
+    return *this;
+  std::uint64_t mask = above_mask(card.suit(), card.rank());
+  if (card.suit() != trump) {
+    mask |= suit_mask(trump);
+    if (card.suit() != led)
+      mask |= suit_mask(led);
   }
-  return out;
+  return Hand(bin64 & mask);
 }
 
-Card Hand::top(Suit su) {
-  if (!len[su])
+Card Hand::top(Suit su) const {
+  std::uint64_t m = bin64 & suit_mask(su);
+  if (!m)
     return Card::NONE;
-  return Card{su, cards[su][len[su] - 1]};
+  return Card(msb64(m));
 }
 
-Card Hand::bottom(Suit su) {
-  if (!len[su])
+Card Hand::bottom(Suit su) const {
+  std::uint64_t m = bin64 & suit_mask(su);
+  if (!m)
     return Card::NONE;
-  return Card{su, cards[su][0]};
+  return Card(ctz64(m));
 }
 
 Card Hand::min_mil_trl(Suit led, Suit trump, const int *len_arr) const {
-  if (!this->nbr_cards)
+  if (!bin64)
     return Card::NONE;
-  if (led != Card::NON_SU && len[led] != 0)
-    return Card(led, cards[led][0]);
-  if (!len_arr)
-    len_arr = len;
-
-  //	uint64_t one13 = (1ull << Card::N_RANKS) - 1;
-  //	uint64_t trump_msk = one13 << (trump * Card::N_RANKS);
+  if (led != Card::NON_SU && len(led) != 0)
+    return bottom(led);
 
   Suit min_s = Card::NON_SU;
   Rank min_r = Card::N_RANKS;
-  uint8_t min_len = Card::N_RANKS + 1;
-  for (Suit s = 0; s < Card::N_SUITS; s++)
-    if (s != trump && len[s] != 0 &&
-        (cards[s][0] < min_r ||
-         (cards[s][0] == min_r && len_arr[s] < min_len))) {
+  int min_len = Card::N_RANKS + 1;
+  for (Suit s = 0; s < Card::N_SUITS; s++) {
+    std::uint64_t m = bin64 & suit_mask(s);
+    if (s == trump || !m)
+      continue;
+    Rank r = ctz64(m) - s * Card::N_RANKS;
+    int l = len_arr ? len_arr[s] : popcount64(m);
+    if (r < min_r || (r == min_r && l < min_len)) {
       min_s = s;
-      min_r = cards[s][0];
-      min_len = len_arr[s];
+      min_r = r;
+      min_len = l;
     }
+  }
   if (min_s != Card::NON_SU)
-    return Card(min_s, cards[min_s][0]);
-  if (trump != Card::NON_SU && len[trump] != 0)
-    return Card(trump, cards[trump][0]);
+    return Card(min_s, min_r);
+  if (trump != Card::NON_SU)
+    return bottom(trump);
   return Card::NONE;
 }
 
 Card Hand::maxLed_maxTr_min_mil(Suit led, Suit trump) const {
-  if (!this->nbr_cards)
+  if (!bin64)
     return Card::NONE;
-  if (led != Card::NON_SU && len[led] != 0)
-    return Card(led, cards[led][len[led] - 1]);
-  if (trump != Card::NON_SU && len[trump] != 0)
-    return Card(trump, cards[trump][len[trump] - 1]);
+  if (led != Card::NON_SU && len(led) != 0)
+    return top(led);
+  if (trump != Card::NON_SU && len(trump) != 0)
+    return top(trump);
   Suit min_s = Card::NON_SU;
   Rank min_r = Card::N_RANKS;
-  uint8_t min_len = Card::N_RANKS + 1;
-  for (Suit s = 0; s < Card::N_SUITS; s++)
-    if (len[s] != 0 &&
-        (cards[s][0] < min_r || (cards[s][0] == min_r && len[s] < min_len))) {
+  int min_len = Card::N_RANKS + 1;
+  for (Suit s = 0; s < Card::N_SUITS; s++) {
+    std::uint64_t m = bin64 & suit_mask(s);
+    if (!m)
+      continue;
+    Rank r = ctz64(m) - s * Card::N_RANKS;
+    int l = popcount64(m);
+    if (r < min_r || (r == min_r && l < min_len)) {
       min_s = s;
-      min_r = cards[s][0];
-      min_len = len[s];
+      min_r = r;
+      min_len = l;
     }
-  return Card(min_s, cards[min_s][0]);
+  }
+  return Card(min_s, min_r);
 }
 
 Hand &Hand::discard(Suit su) {
@@ -419,10 +283,7 @@ Hand &Hand::discard(Suit su) {
     throw std::invalid_argument("Hand::discard(su): invalid suit: " +
                                 std::to_string((int)su));
 #endif
-  nbr_cards -= len[su];
-  len[su] = 0;
-  bin64 &= ~(0x1FFFull << su * Card::N_RANKS);
-
+  bin64 &= ~suit_mask(su);
   return *this;
 }
 
@@ -431,8 +292,7 @@ Hand Hand::sub_hand(Suit su) const {
   if (su >= Card::N_SUITS)
     throw std::invalid_argument("Hand::sub_hand: invalid suit.");
 #endif
-  uint64_t su_bin64 = bin64 & (0x1FFFull << su * Card::N_RANKS);
-  return Hand(su_bin64);
+  return Hand(bin64 & suit_mask(su));
 }
 
 Hand Hand::sub_hand_sup_rank(Suit su, Rank rnk) const {
@@ -442,10 +302,7 @@ Hand Hand::sub_hand_sup_rank(Suit su, Rank rnk) const {
   if (rnk >= Card::N_RANKS)
     throw std::invalid_argument("Hand::sub_hand : invalid rank.");
 #endif
-  uint64_t mask = ((1ull << (Card::N_RANKS - rnk)) - 1)
-                  << (su * Card::N_RANKS + rnk);
-  uint64_t su_bin64 = bin64 & mask;
-  return Hand(su_bin64);
+  return Hand(bin64 & suit_mask(su) & (~0ull << (su * Card::N_RANKS + rnk)));
 }
 
 bool Hand::is_in(const Card &c) const {
@@ -453,30 +310,20 @@ bool Hand::is_in(const Card &c) const {
   if (c == Card::NONE)
     throw std::invalid_argument("Hand::is_in: NONE card.");
 #endif
-  return sorted_is_in<Rank>(cards[c.su], len[c.su], c.rnk);
+  return c.id < Card::N_CARDS && (bin64 >> c.id & 1);
 }
 
 bool Hand::card_is_valid_move(const Card &card, Suit led) const {
-  if (!this->is_in(card)) {
-    LOG("Hand::card_is_valid_move: card " << card.to_string()
-                                          << " is not in the hand.");
-    return false;
-  }
-  if (led == Card::NON_SU)
-    return true;
-  if ((card.su != led) && (len[led] != 0)) {
-    LOG("Hand::card_is_valid_move: card suit is not led : "
-        << Card::SU_STR[led]);
-    return false;
-  }
-  return true;
+  return is_legal_move(*this, card, led);
 }
 
+// Number of cards of the suit ranked in (c_low, c_hi]
 int Hand::diff_between(const Card &c_low, const Card &c_hi) const {
-	Suit s = c_low.su;
-  if (s != c_hi.su || len[s] == 0)
+  Suit s = c_low.suit();
+  if (s != c_hi.suit() || len(s) == 0)
     return 0;
-  int i_low = bisect<Rank>(cards[s], len[s], c_low.rnk);
-  int i_hi = bisect<Rank>(cards[s], len[s], c_hi.rnk);
+  std::uint64_t m = bin64 & suit_mask(s);
+  int i_low = popcount64(m & ~above_mask(s, c_low.rank()));
+  int i_hi = popcount64(m & ~above_mask(s, c_hi.rank()));
   return i_hi - i_low;
 }
@@ -38,6 +38,20 @@ void Hand_test() {
 	std::cout << "h0 uni h1: " << h0.uni(h1).to_string() << std::endl;
 	std::cout << "h0 int h1: " << h0.inter(h1).to_string() << std::endl;
 
+	for (Suit s = 0; s < Card::N_SUITS; s++)
+		std::cout << Card::SU_STR[s] << ": len " << h1.len(s) << ", bottom "
+				<< h1.bottom(s).to_string() << ", top " << h1.top(s).to_string() << std::endl;
+	Hand h3 = h1;
+	h3.rm_top(Card::Spade, 2);
+	std::cout << "h1 rm_top(S, 2): " << h3.to_string() << ", nbr " << h3.nbr_cards() << std::endl;
+
+	for (Suit led = 0; led <= Card::N_SUITS; led++) {
+		std::cout << "legal on led " << Card::SU_STR[led] << ":";
+		for (Cid id : BitIter(legal_moves(h1, led)))
+			std::cout << " " << Card(id).to_string();
+		std::cout << std::endl;
+	}
+
 }
 
 
@@ -0,0 +1,290 @@
+#include "ISMCTSAgent.h"
+
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "MonteCarloAgent.h"
+#include "Trick.h"
+#include "bits.h"
+#include "utils.h"
+
+ISMCTSAgent::ISMCTSAgent(int time_budget_ms, int max_iterations, int nbr_threads, int max_nodes, Rng rng)
+	: SoundAgent(), pool(nbr_threads), nodes(max_nodes), spare(max_nodes)
+{
+	if (max_nodes < 1)
+		throw std::invalid_argument("ISMCTSAgent: max_nodes must be positive");
+	set_budget(time_budget_ms, max_iterations);
+	name = name_tag = "AI_T";
+	for (unsigned w = 0; w < pool.size(); w++)
+		rngs.push_back(rng.fork());
+	clear_tree();
+}
+
+void ISMCTSAgent::set_budget(int time_budget_ms, int max_iterations)
+{
+	if (time_budget_ms <= 0 && max_iterations <= 0)
+		throw std::invalid_argument("ISMCTSAgent: needs a time budget or an iteration cap");
+	timer.set_budget(double(time_budget_ms > 0 ? time_budget_ms : 0) * Hokm::N_TRICKS);
+	this->max_iterations = max_iterations;
+}
+
+void ISMCTSAgent::init_round(const Hand &hand)
+{
+	SoundAgent::init_round(hand);
+	team_scores.fill(0);
+	timer.start_round();
+	clear_tree();
+}
+
+void ISMCTSAgent::trick_result(const State &, const std::array<int, Hokm::N_TEAMS> &scores)
+{
+	team_scores = scores;
+}
+
+int ISMCTSAgent::new_node(Card card, int pl)
+{
+	const int i = nbr_nodes.fetch_add(1, std::memory_order_relaxed);
+	if (i >= int(nodes.size()))
+		return NIL;
+	// the caller counts its own visit
+	Node &n = nodes[i];
+	n.card = card;
+	n.pl = static_cast<std::int8_t>(pl);
+	n.first_child.store(NIL, std::memory_order_relaxed);
+	n.next_sibling = NIL;
+	n.expanded.store(0, std::memory_order_relaxed);
+	n.visits.store(1, std::memory_order_relaxed);
+	n.avail.store(1, std::memory_order_relaxed);
+	n.reward.store(0, std::memory_order_relaxed);
+	return i;
+}
+
+void ISMCTSAgent::clear_tree()
+{
+	nbr_nodes = 0;
+	new_node(Card::NONE, -1);
+	nodes[0].visits = 0;
+	last_card = Card::NONE;
+}
+
+int ISMCTSAgent::find(const Card path[], int len) const
+{
+	int node = 0;
+	for (int k = 0; k < len && node != NIL; k++)
+	{
+		int ch = nodes[node].first_child;
+		while (ch != NIL && nodes[ch].card != path[k])
+			ch = nodes[ch].next_sibling;
+		node = ch;
+	}
+	return node;
+}
+
+int ISMCTSAgent::tree_visits(const Card path[], int len) const
+{
+	const int node = find(path, len);
+	return node == NIL ? 0 : int(nodes[node].visits);
+}
+
+void ISMCTSAgent::advance(const State &state, const History &hist)
+{
+	if (last_card == Card::NONE)
+	{
+		clear_tree();
+		return;
+	}
+	// Our card, the rest of its trick, then the current trick up to us.
+	Card path[2 * Hokm::N_PLAYERS];
+	int len = 0;
+	path[len++] = last_card;
+	for (int o = last_ord + 1; o < Hokm::N_PLAYERS; o++)
+		path[len++] = hist.played_cards[(player_id + o - last_ord) % Hokm::N_PLAYERS].at(-1);
+	const int leader = (player_id + Hokm::N_PLAYERS - state.ord) % Hokm::N_PLAYERS;
+	for (int o = 0; o < state.ord; o++)
+		path[len++] = state.table[(leader + o) % Hokm::N_PLAYERS];
+
+	const int root = find(path, len);
+	if (root == NIL)
+	{
+		clear_tree();
+		return;
+	}
+
+	// Copy the kept subtree breadth-first into `spare`, root first; a copied
+	// node's first_child still points into `nodes` until its turn comes.
+	auto copy = [](Node &dst, const Node &src)
+	{
+		dst.card = src.card;
+		dst.pl = src.pl;
+		dst.first_child.store(src.first_child.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		dst.next_sibling = NIL;
+		dst.expanded.store(0, std::memory_order_relaxed);
+		dst.visits.store(src.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		dst.avail.store(src.avail.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		dst.reward.store(src.reward.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	};
+	copy(spare[0], nodes[root]);
+	int n = 1;
+	for (int head = 0; head < n; head++)
+	{
+		// claims that found the arena full are dropped here
+		std::uint64_t expanded = 0;
+		int prev = NIL;
+		int ch = spare[head].first_child.load(std::memory_order_relaxed);
+		spare[head].first_child.store(NIL, std::memory_order_relaxed);
+		for (; ch != NIL; ch = nodes[ch].next_sibling)
+		{
+			copy(spare[n], nodes[ch]);
+			expanded |= 1ull << nodes[ch].card.id;
+			if (prev == NIL)
+				spare[head].first_child.store(n, std::memory_order_relaxed);
+			else
+				spare[prev].next_sibling = n;
+			prev = n++;
+		}
+		spare[head].expanded.store(expanded, std::memory_order_relaxed);
+	}
+	std::swap(nodes, spare);
+	nbr_nodes = n;
+}
+
+void ISMCTSAgent::iterate(RoundState &st, Rng &rng)
+{
+	constexpr auto relaxed = std::memory_order_relaxed;
+	int path[Card::N_CARDS + 1];
+	int len = 0;
+	int node = 0;
+	nodes[0].visits.fetch_add(1, relaxed);
+	while (!st.done() && !st.decided())
+	{
+		Node &parent = nodes[node];
+		const std::uint64_t legal = st.legal();
+		int best = NIL;
+		double best_score = -1;
+		for (int ch = parent.first_child.load(std::memory_order_acquire); ch != NIL; ch = nodes[ch].next_sibling)
+		{
+			Node &n = nodes[ch];
+			if (!(legal >> n.card.id & 1))
+				continue;
+			const double avail = n.avail.fetch_add(1, relaxed) + 1;
+			const double visits = n.visits.load(relaxed);
+			const double score = n.reward.load(relaxed) / (REWARD_SCALE * visits) +
+								 UCB_C * std::sqrt(std::log(avail) / visits);
+			if (score > best_score)
+			{
+				best_score = score;
+				best = ch;
+			}
+		}
+		const std::uint64_t untried = legal & ~parent.expanded.load(relaxed);
+		if (untried)
+		{
+			const Card c(select64(untried, rng.below(popcount64(untried))));
+			const std::uint64_t bit = 1ull << c.id;
+			// another thread may have claimed the card since; then select
+			if (!(parent.expanded.fetch_or(bit, relaxed) & bit))
+			{
+				const int ch = new_node(c, st.turn());
+				if (ch != NIL)
+				{
+					int head = parent.first_child.load(std::memory_order_acquire);
+					do
+						nodes[ch].next_sibling = head;
+					while (!parent.first_child.compare_exchange_weak(head, ch, std::memory_order_acq_rel,
+																	 std::memory_order_acquire));
+					st.play(c);
+					path[len++] = ch;
+					break;
+				}
+			}
+		}
+		if (best == NIL)
+			break;
+		// virtual loss: the visit counts before the reward comes back
+		nodes[best].visits.fetch_add(1, relaxed);
+		st.play(nodes[best].card);
+		path[len++] = node = best;
+	}
+	MonteCarloAgent::rollout(st, rng);
+	const int scores[Hokm::N_TEAMS] = {st.team_scores[0], st.team_scores[1]};
+	for (int i = 0; i < len; i++)
+	{
+		Node &n = nodes[path[i]];
+		const int tricks = scores[n.pl % Hokm::N_TEAMS];
+		n.reward.fetch_add((tricks >= Hokm::RND_WIN_SCORE) * REWARD_SCALE + tricks, relaxed);
+	}
+}
+
+Card ISMCTSAgent::act(const State &state, const History &hist)
+{
+	return act(state, hist, NO_DEADLINE);
+}
+
+Card ISMCTSAgent::act(const State &state, const History &hist, Deadline hard)
+{
+	const auto start = Clock::now();
+	advance(state, hist);
+	observe(state, hist);
+	const std::uint64_t legal = legal_moves(hand, state.led);
+	Card out(ctz64(legal));
+	nbr_iterations = 0;
+	nbr_reused = nodes[0].visits;
+	if (legal & (legal - 1))
+	{
+		const DealSampler sampler(constraints());
+		const Deadline deadline = timer.deadline(state.trick_id, popcount64(legal), hard);
+		const bool timed = deadline != NO_DEADLINE;
+		// Iterations are handed out from one counter; with a single thread
+		// and no time budget a move depends only on the seed.
+		std::atomic<int> next{0};
+		std::atomic<bool> stop{false};
+		const unsigned nbr_workers = pool.size();
+		pool.parallel_for(nbr_workers, [&](std::size_t, unsigned w)
+		{
+			Rng &rng = rngs[w];
+			bool near = false;
+			for (int k = 0; !stop.load(std::memory_order_relaxed); k++)
+			{
+				if (max_iterations > 0 && next.fetch_add(1, std::memory_order_relaxed) >= max_iterations)
+					break;
+				// the clock is read every few iterations, and every one close
+				// to the deadline
+				if (timed && (near || k % CLOCK_EVERY == CLOCK_EVERY - 1))
+				{
+					const Clock::time_point now = Clock::now();
+					if (now >= deadline)
+						stop = true;
+					near = deadline - now < NEAR_DEADLINE;
+				}
+				std::uint64_t oth[3];
+				if (!sampler.sample(rng, oth))
+					stop = true;
+				if (stop.load(std::memory_order_relaxed))
+					break;
+				RoundState st = determinize(state, oth, team_scores);
+				iterate(st, rng);
+			}
+		});
+		if (nbr_nodes > int(nodes.size()))
+			nbr_nodes = int(nodes.size());
+		nbr_iterations = int(nodes[0].visits) - nbr_reused;
+
+		std::uint32_t most = 0;
+		for (int ch = nodes[0].first_child; ch != NIL; ch = nodes[ch].next_sibling)
+			if ((legal >> nodes[ch].card.id & 1) && nodes[ch].visits > most)
+			{
+				most = nodes[ch].visits;
+				out = nodes[ch].card;
+			}
+		if (most == 0)
+			out = hand.min_mil_trl(state.led, state.trump);
+		LOG(name << ", " << nbr_iterations << " iterations, " << nbr_reused << " reused, " << nbr_nodes
+				 << " nodes, out card: " << out.to_string());
+	}
+	timer.spend(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	record_play(out);
+	last_card = out;
+	return out;
+}
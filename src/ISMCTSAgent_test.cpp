@@ -0,0 +1,110 @@
+/*
+ * ISMCTSAgent_test.cpp
+ */
+#include "ISMCTSAgent.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "GameRound.h"
+
+namespace {
+// Watches the ISMCTS seat 0: before each of its moves, the visits of the
+// node its last card and the plays since lead to in the old tree; after it,
+// the visits the search carried over, which must be the same.
+struct ReuseObserver : NullObserver
+{
+	ISMCTSAgent *agent;
+	int max_iterations;
+	Card since[2 * Hokm::N_PLAYERS];
+	int nbr_since = 0;
+	int expected = -1;
+	int nbr_checked = 0, nbr_reusing = 0, nbr_capped = 0, nbr_searched = 0;
+	long reused = 0;
+	std::vector<Cid> plays;
+
+	void awaiting_card(int pl)
+	{
+		if (pl == 0 && nbr_since > 0)
+			expected = agent->tree_visits(since, nbr_since);
+	}
+	void card_played(int pl, const Card &c, const State &)
+	{
+		plays.push_back(c.id);
+		if (pl != 0)
+		{
+			if (nbr_since > 0)
+				since[nbr_since++] = c;
+			return;
+		}
+		if (expected >= 0)
+		{
+			if (agent->last_reused() != expected)
+				throw std::runtime_error("ISMCTSAgent_test: " + std::to_string(agent->last_reused()) +
+										 " visits reused, the old tree had " + std::to_string(expected));
+			nbr_checked++;
+			nbr_reusing += expected > 0;
+			reused += expected;
+		}
+		if (agent->last_iterations() > 0)
+		{
+			nbr_searched++;
+			nbr_capped += agent->last_iterations() == max_iterations;
+		}
+		expected = -1;
+		since[0] = c;
+		nbr_since = 1;
+	}
+};
+
+// A few rounds of ISMCTS seat 0 and partner against SoundAgents, with an
+// iteration cap and no time budget; GameRound checks every card is legal.
+ReuseObserver play_match(int nbr_threads, int nbr_rounds, std::array<int, Hokm::N_TEAMS> &wins)
+{
+	const int max_iterations = 400;
+	ISMCTSAgent t0(0, max_iterations, nbr_threads, 1 << 14, Rng(18, 0)), t2(0, max_iterations, 1, 1 << 14, Rng(18, 2));
+	SoundAgent s1, s3;
+	GameRound round({&t0, &s1, &t2, &s3}, Rng(18));
+	ReuseObserver obs;
+	obs.agent = &t0;
+	obs.max_iterations = max_iterations;
+	wins.fill(0);
+	for (int r = 0; r < nbr_rounds; r++)
+	{
+		obs.nbr_since = 0;
+		round.reset();
+		round.deal_n_init();
+		round.trump_call();
+		wins[round.play(obs)]++;
+	}
+	return obs;
+}
+}
+
+void ISMCTSAgent_test()
+{
+	const int nbr_rounds = 4;
+	std::array<int, Hokm::N_TEAMS> wins, again_wins, par_wins;
+
+	// One thread: re-rooting keeps the old visits, and the seeds fix the play.
+	const ReuseObserver first = play_match(1, nbr_rounds, wins);
+	if (first.nbr_reusing == 0)
+		throw std::runtime_error("ISMCTSAgent_test: no move reused the tree");
+	if (first.nbr_capped != first.nbr_searched)
+		throw std::runtime_error("ISMCTSAgent_test: a search missed its iteration cap");
+	const ReuseObserver again = play_match(1, nbr_rounds, again_wins);
+	if (again.plays != first.plays || again_wins != wins)
+		throw std::runtime_error("ISMCTSAgent_test: same seeds, different play");
+
+	// Two threads on one tree: the same cap and reuse, though not the same play.
+	const ReuseObserver par = play_match(2, nbr_rounds, par_wins);
+	if (par.nbr_reusing == 0 || par.nbr_capped != par.nbr_searched)
+		throw std::runtime_error("ISMCTSAgent_test: parallel search lost iterations or the tree");
+
+	std::cout << "ISMCTSAgent vs SoundAgent " << wins[0] << ":" << wins[1] << " over " << nbr_rounds
+			  << " rounds, reproducible; " << first.nbr_checked << " moves after the first, " << first.nbr_reusing
+			  << " reusing " << first.reused / std::max(first.nbr_reusing, 1) << " visits on average; 2 threads "
+			  << par_wins[0] << ":" << par_wins[1] << ", " << par.nbr_searched << " searches at the cap" << std::endl;
+}
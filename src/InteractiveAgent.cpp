@@ -12,7 +12,7 @@
 
 InteractiveAgent::InteractiveAgent(bool show_hand)
     : Agent(), show_hand(show_hand) {
-  name = "IN_" + std::to_string(player_id);
+  name = name_tag = "IN_";
 }
 
 void InteractiveAgent::init_game() {
@@ -46,6 +46,7 @@ Card InteractiveAgent::act(const State &state, const History &) {
   }
 
   Card inp_card;
+  std::uint64_t legal = legal_moves(hand, state.led);
 
   do {
     std::string inp_card_str = input("Enter your card: ");
@@ -57,15 +58,15 @@ Card InteractiveAgent::act(const State &state, const History &) {
       output("/ALRWrong string!");
       continue;
     }
-    if (state.led != Card::NON_SU && hand.len[state.led] != 0 &&
-        inp_card.su != state.led) {
-      output("/ALRYou should play the led suit: " + Card::SU_STR[state.led]);
+    if (!hand.is_in(inp_card)) {
+      output("/ALRYou don't have this card!");
       continue;
     }
-    if (!hand.remove(inp_card)) {
-      output("/ALRYou don't have this card!");
+    if (!(legal >> inp_card.id & 1)) {
+      output("/ALRYou should play the led suit: " + Card::SU_STR[state.led]);
       continue;
     }
+    hand.remove(inp_card);
 
     break;
   } while (true);
@@ -12,19 +12,26 @@
 #include <thread>
 
 #include "GameConfig.h"
+#include "ISMCTSAgent.h"
 #include "InteractiveAgent.h"
+#include "MonteCarloAgent.h"
 #include "MultiClientServer.h"
 #include "RemoteInterAgent.h"
 #include "SoundAgent.h"
 #include "utils.h"
 #include "table.h"  // for table_str(...)
 
-static Agent *newAgentFrom(char ag_typ, int, bool show_hand = true) {
+static Agent *newAgentFrom(char ag_typ, MultiClientServer &server,
+                           bool show_hand = true) {
   switch (ag_typ) {
   case 's':
     return new SoundAgent();
+  case 'm':
+    return new MonteCarloAgent(500, 0, 0);
+  case 't':
+    return new ISMCTSAgent(500, 0, 0);
   case 'r':
-    return new RemoteInterAgent(show_hand);
+    return new RemoteInterAgent(server, show_hand);
   case 'i':
     return new InteractiveAgent(show_hand);
   default:
@@ -34,10 +41,12 @@ static Agent *newAgentFrom(char ag_typ, int, bool show_hand = true) {
 
 InteractiveGame::InteractiveGame(std::string ag_typs, bool show_hand,
                                  bool prompt)
-    : prompt{prompt} {
+    : server(new MultiClientServer()), prompt{prompt} {
   LOG("InteractiveGame(...) called.");
-  for (size_t pl = 0; pl < Hokm::N_PLAYERS; pl++)
-    agent[pl] = newAgentFrom(ag_typs[pl], pl, show_hand);
+  for (size_t pl = 0; pl < Hokm::N_PLAYERS; pl++) {
+    agent[pl] = newAgentFrom(ag_typs[pl], *server, show_hand);
+    agent[pl]->set_seat(pl);
+  }
 
   for (auto ag : agent)
     ag->init_game();
@@ -50,13 +59,15 @@ InteractiveGame::InteractiveGame(std::string ag_typs, bool show_hand,
 
   round = std::unique_ptr<GameRound>(new GameRound(agent));
   round->show_info = true;
+  // search agents answer within two seconds at a live table
+  round->move_time_ms = 2000;
   if (prompt) {
     round->turn_sleep_ms = 0;
     round->rnd_sleep_ms = 0;
   }
 
   // NEW: register a resume handler to resend snapshot to a resuming player
-  resume_handler_id = MultiClientServer::instance().add_resume_handler(
+  resume_handler_id = server->add_resume_handler(
       [this](int pid) {
         try { this->sync_on_resume(pid); } catch (...) {}
       }
@@ -67,13 +78,12 @@ InteractiveGame::~InteractiveGame() {
   LOG("~InteractiveGame() called.");
   // Unregister resume handler if still present
   if (resume_handler_id >= 0) {
-    MultiClientServer::instance().remove_resume_handler(resume_handler_id);
+    server->remove_resume_handler(resume_handler_id);
     resume_handler_id = -1;
   }
   for (auto ag : agent)
     delete ag;
-  MultiClientServer::instance().stop();
-  Agent::reset_id();
+  server->stop();
 }
 
 int InteractiveGame::play(int win_score, int round_win_score) {
@@ -143,7 +153,7 @@ void InteractiveGame::sync_on_resume(int pid) {
   // 4) Player's current hand (/HND)
   // Prefer agent's own view (may include last play), fallback to round's stored hand
   Hand ph = agent[pid]->get_hand();
-  if (ph.nbr_cards == 0) {
+  if (ph.nbr_cards() == 0) {
     ph = round->get_player_hand(pid);
   }
   agent[pid]->info("/HND" + ph.to_string());
@@ -8,26 +8,21 @@
 #include "LearningGame.h"
 
 #include <cstring>
+#include <memory>
 #include <vector>
 
 #include "SoundAgent.h"
 #include "RndAgent.h"
+#include "ThreadPool.h"
 #include "utils.h"
 
-LearningGame::LearningGame(int nbr_probs, double min_prob, double max_prob) :
+LearningGame::LearningGame(int nbr_probs, double min_prob, double max_prob, Rng rng, int nbr_threads) :
+	rng(rng),
+	nbr_threads(nbr_threads),
 	nbr_probs(nbr_probs),
 	nbr_stats{0},
 	stats{nullptr}
 {
-	// for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
-	// 	agent[pl] = new SoundAgent();
-	agent[0] = new SoundAgent();
-	agent[1] = new SoundAgent();
-	agent[2] = new SoundAgent();
-	agent[3] = new SoundAgent();
-
-	round = std::unique_ptr<GameRound>(new GameRound(agent));
-
 	probs = new double[nbr_probs];
 
 	for (int i = 0; i < nbr_probs; i++)
@@ -38,61 +33,90 @@ LearningGame::LearningGame(int nbr_probs, double min_prob, double max_prob) :
 
 LearningGame::~LearningGame()
 {
-	for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
-		delete agent[pl];
 	delete[] probs;
 	delete[] stats;
-	 Agent::reset_id();
+}
+
+std::vector<std::array<int, Hokm::N_TEAMS>> LearningGame::play_matchups(const std::vector<Matchup> &matchups,
+																		 int nbr_episodes)
+{
+	ThreadPool pool(nbr_threads);
+
+	// One table of agents per worker.
+	std::vector<std::array<std::unique_ptr<SoundAgent>, Hokm::N_PLAYERS>> tables(pool.size());
+	for (auto &table : tables)
+		for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+		{
+			table[pl].reset(new SoundAgent());
+			table[pl]->set_seat(pl);
+		}
+
+	// Task t is episode t % nbr_episodes of matchup t / nbr_episodes, played on
+	// a fresh round seeded by (seed, t): its outcome doesn't depend on which
+	// worker runs it or what ran there before.
+	const std::uint64_t seed = rng();
+	const std::size_t nbr_tasks = matchups.size() * nbr_episodes;
+	std::vector<std::array<int, Hokm::N_TEAMS>> task_wins(nbr_tasks);
+	pool.parallel_for(nbr_tasks, [&](std::size_t t, unsigned w)
+	{
+		const Matchup &m = matchups[t / nbr_episodes];
+		std::array<Agent *, Hokm::N_PLAYERS> agent;
+		for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+		{
+			SoundAgent *ag = tables[w][pl].get();
+			int team = pl % Hokm::N_TEAMS;
+			if (m.tuned[team])
+				ag->set_probs(m.floor[team], m.trump_cap[team]);
+			else
+				ag->set_probs(SoundAgent::DEF_PROB_FLOOR);
+			agent[pl] = ag;
+		}
+
+		GameRound round(agent, Rng(seed, t));
+		std::array<int, Hokm::N_TEAMS> wins{};
+		for (int r = 1; r <= 2 * Hokm::WIN_SCORE; r++)
+		{
+			round.reset();
+			round.deal_n_init();
+			round.trump_call();
+			wins[round.play()]++;
+		}
+		for (auto ag : agent)
+			ag->fin_game();
+		task_wins[t] = wins;
+		LOG("e: " << t % nbr_episodes << ", winner team: " << ((wins[0] >= Hokm::WIN_SCORE) ? 1 : 2));
+	});
+
+	std::vector<std::array<int, Hokm::N_TEAMS>> out(matchups.size());
+	for (std::size_t t = 0; t < nbr_tasks; t++)
+		for (int team = 0; team < Hokm::N_TEAMS; team++)
+			out[t / nbr_episodes][team] += task_wins[t][team];
+	return out;
 }
 
 void LearningGame::tweak_floor_trump_probs(int nbr_episodes)
 {
 
 	nbr_stats = nbr_probs * nbr_probs;
+	delete[] stats;
 	stats = new double[nbr_stats];
 	std::fill((stats), (stats + nbr_stats), 0);
 
+	std::vector<Matchup> matchups;
+	std::vector<std::array<int, Hokm::N_TEAMS>> cells;
 	for (int i1 = 0; i1 < nbr_probs - 1; i1++)
-	{
 		for (int j1 = i1 + 1; j1 < nbr_probs; j1++)
-		{
-			((SoundAgent *)agent[0])->set_probs(probs[i1], probs[j1]);
-			((SoundAgent *)agent[2])->set_probs(probs[i1], probs[j1]);
 			for (int i2 = 0; i2 < nbr_probs - 1; i2++)
-			{
 				for (int j2 = i2 + 1; j2 < nbr_probs; j2++)
 				{
-					((SoundAgent *)agent[1])->set_probs(probs[i2], probs[j2]);
-					((SoundAgent *)agent[3])->set_probs(probs[i2], probs[j2]);
-
-					for (int e = 0; e < nbr_episodes; e++)
-					{
-						int nbr_team_0_wins = 0;
-						for (int r = 1; r <= 2 * Hokm::WIN_SCORE; r++)
-						{
-							round->reset();
-							round->deal_n_init();
-							round->trump_call();
-							int winner_team = round->play();
-
-							if (winner_team == 0)
-							{
-								stats[i1 * nbr_probs + j1]++;
-								nbr_team_0_wins++;
-							}
-							else
-								stats[i2 * nbr_probs + j2]++;
-						}
-						for (auto ag : agent)
-							ag->fin_game();
-						LOG(
-							"e: " << e << ", winner team: " << ((nbr_team_0_wins > 6) ? 1 : 2));
-						round->winner_team = -1;
-					}
+					matchups.push_back({{true, true}, {probs[i1], probs[i2]}, {probs[j1], probs[j2]}});
+					cells.push_back({i1 * nbr_probs + j1, i2 * nbr_probs + j2});
 				}
-			}
-		}
-	}
+	auto wins = play_matchups(matchups, nbr_episodes);
+	for (std::size_t m = 0; m < matchups.size(); m++)
+		for (int team = 0; team < Hokm::N_TEAMS; team++)
+			stats[cells[m][team]] += wins[m][team];
+
 	double mx_cnt = 0;
 	double op_max_p = 1;
 	double op_min_p = 0;
@@ -119,86 +143,48 @@ void LearningGame::tweak_trump_prob_cap(int nbr_episodes)
 {
 
 	nbr_stats = nbr_probs;
+	delete[] stats;
 	stats = new double[nbr_stats];
 	std::fill((stats), (stats + nbr_stats), 0);
 
+	std::vector<Matchup> matchups;
+	std::vector<std::array<int, Hokm::N_TEAMS>> cells;
 	for (int i = 0; i < nbr_probs; i++)
-	{
-		((SoundAgent *)agent[0])->set_probs(0, probs[i]);
-		((SoundAgent *)agent[2])->set_probs(0, probs[i]);
 		for (int j = 0; j < nbr_probs; j++)
 		{
 			if (j == i)
 				continue;
-			((SoundAgent *)agent[1])->set_probs(0, probs[j]);
-			((SoundAgent *)agent[3])->set_probs(0, probs[j]);
-
-			for (int e = 0; e < nbr_episodes; e++)
-			{
-				int nbr_team_0_wins = 0;
-				for (int r = 1; r <= 2 * Hokm::WIN_SCORE; r++)
-				{
-					round->reset();
-					round->deal_n_init();
-					round->trump_call();
-					int winner_team = round->play();
-
-					if (winner_team == 0)
-					{
-						stats[i]++;
-						nbr_team_0_wins++;
-					}
-					else
-						stats[j]++;
-				}
-				for (auto ag : agent)
-					ag->fin_game();
-				LOG(
-					"e: " << e << ", winner team: " << ((nbr_team_0_wins > 6) ? 1 : 2));
-				round->winner_team = -1;
-			}
+			matchups.push_back({{true, true}, {0, 0}, {probs[i], probs[j]}});
+			cells.push_back({i, j});
 		}
-	}
+	auto wins = play_matchups(matchups, nbr_episodes);
+	for (std::size_t m = 0; m < matchups.size(); m++)
+		for (int team = 0; team < Hokm::N_TEAMS; team++)
+			stats[cells[m][team]] += wins[m][team];
 }
 
 void LearningGame::tweak_floor_prob(int nbr_episodes)
 {
 
 	nbr_stats = nbr_probs;
+	delete[] stats;
 	stats = new double[nbr_stats];
 	std::fill((stats), (stats + nbr_stats), 0);
 
+	std::vector<Matchup> matchups;
+	std::vector<std::array<int, Hokm::N_TEAMS>> cells;
 	for (int i = 0; i < nbr_probs; i++)
-	{
-		((SoundAgent *)agent[0])->set_probs(probs[i]);
-		((SoundAgent *)agent[2])->set_probs(probs[i]);
 		for (int j = 0; j < nbr_probs; j++)
 		{
 			if (j == i)
 				continue;
-			((SoundAgent *)agent[1])->set_probs(probs[j]);
-			((SoundAgent *)agent[3])->set_probs(probs[j]);
-
-			for (int e = 0; e < nbr_episodes; e++)
-			{
-				for (int r = 1; r <= 2 * Hokm::WIN_SCORE; r++)
-				{
-					round->reset();
-					round->deal_n_init();
-					round->trump_call();
-					int winner_team = round->play();
-
-					if (winner_team == 0)
-						stats[i]++;
-					else
-						stats[j]++;
-				}
-				for (auto ag : agent)
-					ag->fin_game();
-				round->winner_team = -1;
-			}
+			matchups.push_back({{true, true}, {probs[i], probs[j]}, {1, 1}});
+			cells.push_back({i, j});
 		}
-	}
+	auto wins = play_matchups(matchups, nbr_episodes);
+	for (std::size_t m = 0; m < matchups.size(); m++)
+		for (int team = 0; team < Hokm::N_TEAMS; team++)
+			stats[cells[m][team]] += wins[m][team];
 
 	for (int i = 0; i < nbr_probs; i++)
 	{
@@ -224,34 +210,20 @@ void LearningGame::tweak_floor_prob(int nbr_episodes)
 void LearningGame::tweak_floor_prob_vs_rnd(int nbr_episodes)
 {
 	nbr_stats = nbr_probs;
+	delete[] stats;
 	stats = new double[nbr_stats];
 	// int rnd_wins[nbr_stats] = {0};
 	std::vector<int> rnd_wins(nbr_stats, 0);
 	std::fill(stats, stats + nbr_stats, 0);
 
+	std::vector<Matchup> matchups;
+	for (int i = 0; i < nbr_probs; i++)
+		matchups.push_back({{true, false}, {probs[i], 0}, {1, 1}});
+	auto wins = play_matchups(matchups, nbr_episodes);
 	for (int i = 0; i < nbr_probs; i++)
 	{
-		((SoundAgent *)agent[0])->set_probs(probs[i]);
-		((SoundAgent *)agent[2])->set_probs(probs[i]);
-
-		for (int e = 0; e < nbr_episodes; e++)
-		{
-			for (int r = 1; r <= 2 * Hokm::WIN_SCORE; r++)
-			{
-				round->reset();
-				round->deal_n_init();
-				round->trump_call();
-				int winner_team = round->play();
-
-				if (winner_team == 0)
-					stats[i]++;
-				else
-					rnd_wins[i]++;
-			}
-			for (auto ag : agent)
-				ag->fin_game();
-			round->winner_team = -1;
-		}
+		stats[i] += wins[i][0];
+		rnd_wins[i] += wins[i][1];
 	}
 
 	std::cout << "Probs:\n";
@@ -1,9 +1,52 @@
-/*
- * LearningGame_test.cpp
- *
- *  Created on: May 31, 2023
- *      Author: mear
- */
-
-#include "LearningGame.h"
-
+/*
+ * LearningGame_test.cpp
+ *
+ *  Created on: May 31, 2023
+ *      Author: mear
+ */
+
+#include "LearningGame.h"
+
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+// Stats of one sweep on a fixed seed with `nbr_threads` workers.
+std::vector<double> sweep_stats(int nbr_probs, int nbr_threads, void (LearningGame::*sweep)(int))
+{
+	LearningGame game{nbr_probs, 0.3, 0.7, Rng(11), nbr_threads};
+	(game.*sweep)(1);
+	std::vector<double> stats(game.get_nbr_stats());
+	game.cp_stats(stats.data());
+	return stats;
+}
+}
+
+void LearningGame_test()
+{
+	// play()'s sweep, and the grid of floor and trump cap pairs
+	const struct
+	{
+		const char *name;
+		int nbr_probs;
+		void (LearningGame::*sweep)(int);
+	} sweeps[] = {{"play", 2, &LearningGame::play},
+				  {"floor_trump", 3, &LearningGame::tweak_floor_trump_probs}};
+	for (const auto &sw : sweeps)
+	{
+		const std::vector<double> one = sweep_stats(sw.nbr_probs, 1, sw.sweep);
+		const std::vector<double> three = sweep_stats(sw.nbr_probs, 3, sw.sweep);
+		std::cout << "LearningGame " << sw.name << " stats, 1 vs 3 threads:";
+		for (const auto *stats : {&one, &three})
+			for (double s : *stats)
+				std::cout << " " << s;
+		std::cout << std::endl;
+		if (std::accumulate(one.begin(), one.end(), 0.0) == 0)
+			throw std::runtime_error(std::string("LearningGame_test: ") + sw.name + " sweep counted no wins");
+		if (one != three)
+			throw std::runtime_error(std::string("LearningGame_test: ") + sw.name + " sweep depends on the thread count");
+	}
+}
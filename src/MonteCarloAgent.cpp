@@ -0,0 +1,163 @@
+#include "MonteCarloAgent.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <stdexcept>
+
+#include "DealSampler.h"
+#include "Trick.h"
+#include "bits.h"
+#include "utils.h"
+
+MonteCarloAgent::MonteCarloAgent(int time_budget_ms, int max_samples, int nbr_threads, int dd_tricks, Rng rng)
+	: SoundAgent(), timer(double(std::max(time_budget_ms, 0)) * Hokm::N_TRICKS), max_samples(max_samples), dd_tricks(dd_tricks),
+	  pool(nbr_threads)
+{
+	if (time_budget_ms <= 0 && max_samples <= 0)
+		throw std::invalid_argument("MonteCarloAgent: needs a time budget or a sample cap");
+	name = name_tag = "AI_M";
+	for (unsigned w = 0; w < pool.size(); w++)
+	{
+		rngs.push_back(rng.fork());
+		solvers.emplace_back(new DoubleDummy(18));
+	}
+}
+
+void MonteCarloAgent::init_round(const Hand &hand)
+{
+	SoundAgent::init_round(hand);
+	team_scores.fill(0);
+	timer.start_round();
+}
+
+void MonteCarloAgent::trick_result(const State &, const std::array<int, Hokm::N_TEAMS> &scores)
+{
+	team_scores = scores;
+}
+
+Card MonteCarloAgent::act(const State &state, const History &hist)
+{
+	return act(state, hist, NO_DEADLINE);
+}
+
+Card MonteCarloAgent::act(const State &state, const History &hist, Deadline hard)
+{
+	const auto start = Clock::now();
+	observe(state, hist);
+	const std::uint64_t legal = legal_moves(hand, state.led);
+	Card out(ctz64(legal));
+	nbr_samples = 0;
+	if (legal & (legal - 1))
+	{
+		const DealSampler sampler(constraints());
+		const bool use_dd = Hokm::N_TRICKS - state.trick_id <= dd_tricks;
+		const Deadline deadline = timer.deadline(state.trick_id, popcount64(legal), hard);
+		const bool timed = deadline != NO_DEADLINE;
+
+		// A task per worker, each with its share of the sample cap; with a
+		// single thread and no time budget a move depends only on the seed.
+		const unsigned nbr_workers = pool.size();
+		std::vector<std::array<double, Card::N_CARDS>> sums(nbr_workers);
+		std::vector<int> counts(nbr_workers, 0);
+		for (auto &sum : sums)
+			sum.fill(0);
+		pool.parallel_for(nbr_workers, [&](std::size_t t, unsigned w)
+		{
+			const int quota = max_samples > 0 ? int((max_samples + nbr_workers - 1 - t) / nbr_workers) : INT_MAX;
+			Rng &rng = rngs[w];
+			auto &sum = sums[w];
+			for (int k = 0; k < quota; k++)
+			{
+				if (timed && Clock::now() >= deadline)
+					break;
+				std::uint64_t oth[3];
+				if (!sampler.sample(rng, oth))
+					break;
+				RoundState st = determinize(state, oth, team_scores);
+
+				// a round won counts for more than all the tricks
+				auto value = [](int tricks)
+				{ return (tricks >= Hokm::RND_WIN_SCORE) + tricks / (Hokm::N_TRICKS + 1.0); };
+				if (use_dd)
+				{
+					Card cards[Card::N_RANKS];
+					int tricks[Card::N_RANKS];
+					// a solve still running at the deadline is dropped
+					const int n = solvers[w]->solve_moves(st, cards, tricks, deadline);
+					if (n == 0)
+						break;
+					for (int i = 0; i < n; i++)
+						sum[cards[i].id] += value(tricks[i]);
+				}
+				else
+					for (Cid id : BitIter(legal))
+					{
+						RoundState r = st;
+						r.play(Card(id));
+						rollout(r, rng);
+						sum[id] += value(r.team_scores[team_id]);
+					}
+				counts[w]++;
+			}
+		});
+
+		for (unsigned w = 0; w < nbr_workers; w++)
+			nbr_samples += counts[w];
+		if (nbr_samples == 0)
+			out = hand.min_mil_trl(state.led, state.trump);
+		else
+		{
+			double best = -1;
+			for (Cid id : BitIter(legal))
+			{
+				double v = 0;
+				for (unsigned w = 0; w < nbr_workers; w++)
+					v += sums[w][id];
+				if (v > best)
+				{
+					best = v;
+					out = Card(id);
+				}
+			}
+		}
+		LOG(name << ", " << nbr_samples << (use_dd ? " double-dummy" : " rollout") << " samples, out card: "
+				 << out.to_string());
+	}
+	timer.spend(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	record_play(out);
+	return out;
+}
+
+void MonteCarloAgent::rollout(RoundState &st, Rng &rng)
+{
+	// Random leads; followers play the cheapest card that takes the trick
+	// unless the partner already has it, and their lowest card otherwise.
+	while (!st.done() && !st.decided())
+	{
+		const std::uint64_t legal = st.legal();
+		if (st.ord == 0)
+		{
+			st.play(Card(select64(legal, rng.below(popcount64(legal)))));
+			continue;
+		}
+		const std::uint8_t *key = Hokm::TRICK_KEYS.key[st.led][st.trump];
+		int best = -1, best_seat = 0;
+		for (int p = 0; p < Hokm::N_PLAYERS; p++)
+			if (st.table[p] != Card::NONE && key[st.table[p].id] > best)
+			{
+				best = key[st.table[p].id];
+				best_seat = p;
+			}
+		const bool partner_ahead = best_seat % Hokm::N_TEAMS == st.turn() % Hokm::N_TEAMS;
+		Cid low = -1, win = -1;
+		for (Cid id : BitIter(legal))
+		{
+			if (low < 0 || key[id] < key[low])
+				low = id;
+			if (key[id] > best && (win < 0 || key[id] < key[win]))
+				win = id;
+		}
+		st.play(Card((partner_ahead || win < 0) ? low : win));
+	}
+}
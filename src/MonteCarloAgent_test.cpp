@@ -0,0 +1,82 @@
+/*
+ * MonteCarloAgent_test.cpp
+ */
+#include "MonteCarloAgent.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "GameRound.h"
+
+namespace {
+// Checks each card against the hand it came from and the sample count of
+// the Monte Carlo seats on every move with a choice; records the plays.
+struct CheckingObserver : NullObserver
+{
+	GameRound *round;
+	MonteCarloAgent *mc[Hokm::N_PLAYERS] = {};
+	int max_samples;
+	Hand before;
+	int nbr_choices = 0;
+	std::vector<Cid> plays;
+
+	void awaiting_card(int pl) { before = round->get_player_hand(pl); }
+	void card_played(int pl, const Card &c, const State &st)
+	{
+		const Suit led = st.ord == 0 ? Card::NON_SU : st.led;
+		if (!is_legal_move(before, c, led))
+			throw std::runtime_error("MonteCarloAgent_test: illegal card " + c.to_string());
+		const std::uint64_t legal = legal_moves(before, led);
+		if (mc[pl] && (legal & (legal - 1)))
+		{
+			if (mc[pl]->last_samples() != max_samples)
+				throw std::runtime_error("MonteCarloAgent_test: move scored on " +
+										 std::to_string(mc[pl]->last_samples()) + " deals");
+			nbr_choices++;
+		}
+		plays.push_back(c.id);
+	}
+};
+
+// A few rounds of two single-threaded Monte Carlo seats against SoundAgents;
+// with a sample cap and no time budget they depend only on the seeds.
+CheckingObserver play_match(int nbr_rounds, std::array<int, Hokm::N_TEAMS> &wins)
+{
+	const int max_samples = 12;
+	MonteCarloAgent mc0(0, max_samples, 1, 6, Rng(14, 0)), mc2(0, max_samples, 1, 6, Rng(14, 2));
+	SoundAgent s1, s3;
+	GameRound round({&mc0, &s1, &mc2, &s3}, Rng(14));
+	CheckingObserver obs;
+	obs.round = &round;
+	obs.mc[0] = &mc0;
+	obs.mc[2] = &mc2;
+	obs.max_samples = max_samples;
+	wins.fill(0);
+	for (int r = 0; r < nbr_rounds; r++)
+	{
+		round.reset();
+		round.deal_n_init();
+		round.trump_call();
+		wins[round.play(obs)]++;
+	}
+	return obs;
+}
+}
+
+void MonteCarloAgent_test()
+{
+	const int nbr_rounds = 4;
+	std::array<int, Hokm::N_TEAMS> wins, again_wins;
+	const CheckingObserver first = play_match(nbr_rounds, wins);
+	if (first.nbr_choices == 0)
+		throw std::runtime_error("MonteCarloAgent_test: no move with a choice");
+	const CheckingObserver again = play_match(nbr_rounds, again_wins);
+	if (again.plays != first.plays || again_wins != wins)
+		throw std::runtime_error("MonteCarloAgent_test: same seeds, different play");
+
+	std::cout << "MonteCarloAgent vs SoundAgent " << wins[0] << ":" << wins[1] << " over " << nbr_rounds << " rounds, "
+			  << first.nbr_choices << " moves with a choice, " << first.plays.size() << " cards, reproducible"
+			  << std::endl;
+}
@@ -17,11 +17,6 @@
 
 static constexpr int LISTEN_BACKLOG = 16;
 
-MultiClientServer &MultiClientServer::instance() {
-  static MultiClientServer inst;
-  return inst;
-}
-
 void MultiClientServer::ensure_started(uint16_t port) {
   LOG("MultiClientServer::ensure_started(.) called.");
   bool expected = false;
@@ -10,14 +10,11 @@
 ProbHand &ProbHand::update(const Hand &h, double prob)
 {
     assert(0 <= prob && prob <= 1);
-    if (h.nbr_cards == 0)
-        return *this;
-    for (Suit s = 0; s < Card::N_SUITS; s++)
-        for (int i = 0; i < h.len[s]; i++)
-        {
-            Rank r = h.cards[s][i];
-            this->prob[s][r] = prob;
-        }
+    for (Cid id : BitIter(h.bin64))
+    {
+        Card c(id);
+        this->prob[c.suit()][c.rank()] = prob;
+    }
     return *this;
 }
 
@@ -55,7 +52,7 @@ ProbHand &ProbHand::renormalize(double N)
 double ProbHand::getProb(const Card &c) const
 {
     assert(c != Card::NONE);
-    return prob[c.su][c.rnk];
+    return prob[c.suit()][c.rank()];
 }
 
 ProbHand &ProbHand::update(const Card &c, double prob)
@@ -63,7 +60,7 @@ ProbHand &ProbHand::update(const Card &c, double prob)
     if (c == Card::NONE)
         return *this;
     assert(0 <= prob && prob <= 1);
-    this->prob[c.su][c.rnk] = prob;
+    this->prob[c.suit()][c.rank()] = prob;
     return *this;
 }
 
@@ -96,12 +93,11 @@ double ProbHand::total(Suit s) const
 double ProbHand::total(const Hand &h) const
 {
     double sum = 0;
-    for (Suit s = 0; s < Card::N_SUITS; s++)
-        for (int i = 0; i < h.len[s]; i++)
-        {
-            Rank r = h.cards[s][i];
-            sum += this->prob[s][r];
-        }
+    for (Cid id : BitIter(h.bin64))
+    {
+        Card c(id);
+        sum += this->prob[c.suit()][c.rank()];
+    }
     return sum;
 }
 
@@ -113,12 +109,11 @@ int ProbHand::nbr() const
 double ProbHand::probIn(const Hand &h) const
 {
     double prb = 1.0;
-    for (Suit s = 0; s < Card::N_SUITS; s++)
-        for (int i = 0; i < h.len[s]; i++)
-        {
-            Rank r = h.cards[s][i];
-            prb *= this->prob[s][r];
-        }
+    for (Cid id : BitIter(h.bin64))
+    {
+        Card c(id);
+        prb *= this->prob[c.suit()][c.rank()];
+    }
     return prb;
 }
 
@@ -134,12 +129,11 @@ double ProbHand::probNotIn(Suit s) const
 double ProbHand::probNotIn(const Hand &h) const
 {
     double prb = 1.0;
-    for (Suit s = 0; s < Card::N_SUITS; s++)
-        for (int i = 0; i < h.len[s]; i++)
-        {
-            Rank r = h.cards[s][i];
-            prb *= (1.0 - this->prob[s][r]);
-        }
+    for (Cid id : BitIter(h.bin64))
+    {
+        Card c(id);
+        prb *= (1.0 - this->prob[c.suit()][c.rank()]);
+    }
     return prb;
 }
 
@@ -200,13 +194,12 @@ Hand ProbHand::bound(double gte_prb, double lt_prb) const
 Hand ProbHand::lte(double prob, const Hand &filter) const
 {
     Hand out;
-    for (Suit s = 0; s < Card::N_SUITS; s++)
-        for (int i = 0; i < filter.len[s]; i++)
-        {
-            Rank r = filter.cards[s][i];
-            if (this->prob[s][r] <= prob)
-                out.add(Card(s, r));
-        }
+    for (Cid id : BitIter(filter.bin64))
+    {
+        Card c(id);
+        if (this->prob[c.suit()][c.rank()] <= prob)
+            out.add(c);
+    }
     return out;
 }
 
@@ -0,0 +1,53 @@
+/*
+ * Rng_test.cpp
+ */
+#include "Rng.h"
+
+#include <iostream>
+#include <stdexcept>
+
+#include "CardStack.h"
+#include "Deck.h"
+
+void Rng_test()
+{
+	Rng a(42), b(42), c(42, 1);
+	int same = 0, same_stream = 0;
+	for (int i = 0; i < 1000; i++)
+	{
+		std::uint64_t x = a();
+		same += (x == b());
+		same_stream += (x == c());
+	}
+	std::cout << "seed 42 twice: " << same << "/1000 equal; stream 1 of seed 42: " << same_stream
+			  << "/1000 equal" << std::endl;
+
+	int hist[5] = {0};
+	const int n = 100000;
+	for (int i = 0; i < n; i++)
+		hist[a.below(5)]++;
+	std::cout << "below(5) x " << n << ":";
+	for (int h : hist)
+		std::cout << " " << h;
+	std::cout << std::endl;
+
+	CardStack s1(Hand::ALL_MASK), s2(Hand::ALL_MASK);
+	Rng r1 = Rng(7).fork(), r2 = Rng(7).fork();
+	s1.shuffle(r1);
+	s2.shuffle(r2);
+	bool stacks_eq = s1.to_string() == s2.to_string();
+	std::cout << "forked shuffle, seed 7: " << s1.to_string() << std::endl;
+
+	Deck d1, d2;
+	CardStack h1[4], h2[4];
+	Rng g1(3), g2(3);
+	d1.shuffle_deal(g1, h1, 0);
+	d2.shuffle_deal(g2, h2, 0);
+	bool deals_eq = true;
+	for (int pl = 0; pl < 4; pl++)
+		deals_eq = deals_eq && h1[pl].to_string() == h2[pl].to_string();
+	std::cout << "same seed, same deal: " << deals_eq << std::endl;
+
+	if (same != 1000 || same_stream > 1 || !stacks_eq || !deals_eq)
+		throw std::runtime_error("Rng_test: a seed does not reproduce its stream");
+}
@@ -0,0 +1,74 @@
+#include "RoundState.h"
+
+RoundState::RoundState(const std::uint64_t hands[Hokm::N_PLAYERS], Suit trump, int leader)
+	: table{}, trump(trump), led(Card::NON_SU), leader(leader), ord(0), trick_id(0),
+	  team_scores{0}, nbr_moves(0), hand_key{0}, played_key(0)
+{
+	for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+	{
+		hand[pl] = hands[pl];
+		for (Cid id : BitIter(hand[pl]))
+			hand_key[pl] ^= Hokm::ZOBRIST.hand[pl][id];
+	}
+	key = compute_key();
+}
+
+RoundState::RoundState(const RoundSnapshot &snap)
+	: RoundState(snap.hand, snap.trump, snap.turn)
+{
+	trick_id = snap.nbr_tricks;
+	for (int team = 0; team < Hokm::N_TEAMS; team++)
+		team_scores[team] = snap.team_scores[team];
+	// the leader of each finished trick took the one before it
+	for (int t = 0, first = snap.opening_player; t < snap.nbr_tricks; t++)
+	{
+		for (int k = 0; k < Hokm::N_PLAYERS; k++)
+		{
+			const int pl = (first + k) % Hokm::N_PLAYERS;
+			played_key ^= Hokm::ZOBRIST.played[t * Hokm::N_PLAYERS + k][pl][snap.plays[t][pl].id];
+		}
+		first = Hokm::trick_winner(snap.plays[t], snap.plays[t][first].suit(), trump);
+	}
+	key = compute_key();
+	int on_table = 0;
+	for (Card c : snap.table)
+		on_table += (c != Card::NONE);
+	// A full table is a trick GameRound has resolved but not cleared yet.
+	if (on_table == Hokm::N_PLAYERS)
+		return;
+	for (int k = 0; k < on_table; k++)
+	{
+		int pl = (leader + k) % Hokm::N_PLAYERS;
+		hand[pl] |= 1ull << snap.table[pl].id;
+		hand_key[pl] ^= Hokm::ZOBRIST.hand[pl][snap.table[pl].id];
+		key ^= Hokm::ZOBRIST.hand[pl][snap.table[pl].id];
+		play(snap.table[pl]);
+	}
+}
+
+std::uint64_t RoundState::compute_key() const
+{
+	const auto &z = Hokm::ZOBRIST;
+	std::uint64_t k = z.turn[turn()] ^ z.trump[trump] ^ z.led[led];
+	for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+	{
+		for (Cid id : BitIter(hand[pl]))
+			k ^= z.hand[pl][id];
+		if (table[pl] != Card::NONE)
+			k ^= z.table[pl][table[pl].id];
+	}
+	for (int team = 0; team < Hokm::N_TEAMS; team++)
+		k ^= z.score[team][team_scores[team]];
+	return k;
+}
+
+std::string RoundState::to_string() const
+{
+	std::string out = "trick " + std::to_string(trick_id) + ", leader " + std::to_string(leader) +
+					  ", to move " + std::to_string(turn()) + ", led " + Card::SU_STR[led] + ", trump " +
+					  Card::SU_STR[trump] + ", scores " + std::to_string(team_scores[0]) + ":" +
+					  std::to_string(team_scores[1]);
+	for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+		out += "\n" + std::to_string(pl) + ": " + table[pl].to_string() + " | " + Hand(hand[pl]).to_string();
+	return out;
+}
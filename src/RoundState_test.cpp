@@ -0,0 +1,117 @@
+/*
+ * RoundState_test.cpp
+ */
+#include "RoundState.h"
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include "Rng.h"
+
+namespace {
+bool same_position(const RoundState &a, const RoundState &b)
+{
+	return std::memcmp(a.hand, b.hand, sizeof(a.hand)) == 0 && std::memcmp(a.table, b.table, sizeof(a.table)) == 0 &&
+		   a.led == b.led && a.leader == b.leader && a.ord == b.ord && a.trick_id == b.trick_id &&
+		   a.team_scores[0] == b.team_scores[0] && a.team_scores[1] == b.team_scores[1] && a.nbr_moves == b.nbr_moves &&
+		   a.key == b.key && a.played_key == b.played_key;
+}
+}
+
+void RoundState_test()
+{
+	Rng rng(5);
+	const int nbr_deals = 2000;
+	int bad_undo = 0, bad_score = 0, bad_key = 0;
+	for (int d = 0; d < nbr_deals; d++)
+	{
+		Cid ids[Card::N_CARDS];
+		for (Cid id = 0; id < Card::N_CARDS; id++)
+			ids[id] = id;
+		for (int i = Card::N_CARDS - 1; i > 0; i--)
+			std::swap(ids[i], ids[rng.below(i + 1)]);
+		std::uint64_t hands[Hokm::N_PLAYERS] = {0};
+		for (int i = 0; i < Card::N_CARDS; i++)
+			hands[i % Hokm::N_PLAYERS] |= 1ull << ids[i];
+
+		const RoundState start(hands, rng.below(Card::N_SUITS), rng.below(Hokm::N_PLAYERS));
+		RoundState st = start;
+		// reference trick resolution through Card::cmp
+		int ref_scores[Hokm::N_TEAMS] = {0};
+		Card trick[Hokm::N_PLAYERS];
+		int first = st.leader;
+		while (!st.done())
+		{
+			std::uint64_t legal = st.legal();
+			int pl = st.turn();
+			Card c(select64(legal, rng.below(popcount64(legal))));
+			trick[pl] = c;
+			int w = st.play(c);
+			bad_key += (st.key != st.compute_key());
+			if (w >= 0)
+			{
+				int best = first;
+				for (int k = 1; k < Hokm::N_PLAYERS; k++)
+				{
+					int p = (first + k) % Hokm::N_PLAYERS;
+					if (Card::cmp(trick[p], trick[best], trick[first].suit(), st.trump) > 0)
+						best = p;
+				}
+				ref_scores[best % Hokm::N_TEAMS]++;
+				first = best;
+			}
+		}
+		bad_score += (ref_scores[0] != st.team_scores[0] || ref_scores[1] != st.team_scores[1]);
+		while (st.nbr_moves)
+		{
+			st.undo();
+			bad_key += (st.key != st.compute_key());
+		}
+		bad_undo += !same_position(st, start);
+	}
+	// Seat 0 can't tell deals apart that differ only in the other hands.
+	std::uint64_t hands[Hokm::N_PLAYERS] = {0};
+	for (Cid id = 0; id < Card::N_CARDS; id++)
+		hands[id % Hokm::N_PLAYERS] |= 1ull << id;
+	RoundState a(hands, Card::Spade, 0);
+	std::swap(hands[1], hands[2]);
+	RoundState b(hands, Card::Spade, 0);
+	a.play(Card(0));
+	b.play(Card(0));
+	bool infoset_ok = a.infoset_key(0) == b.infoset_key(0) && a.key != b.key && a.infoset_key(1) != b.infoset_key(1);
+
+	// The same plays grouped into two tricks differently: seat 0 leads and
+	// takes both times and the positions agree, but the histories do not.
+	// The snapshot of the first history keys its plays the same way.
+	const Card grouping[2][2][Hokm::N_PLAYERS] = {
+		{{Card(0, 12), Card(0, 0), Card(0, 2), Card(0, 4)}, {Card(0, 11), Card(0, 1), Card(0, 3), Card(0, 5)}},
+		{{Card(0, 12), Card(0, 0), Card(0, 3), Card(0, 4)}, {Card(0, 11), Card(0, 1), Card(0, 2), Card(0, 5)}}};
+	std::uint64_t short_hands[Hokm::N_PLAYERS] = {0};
+	for (const auto &trick : grouping[0])
+		for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+			short_hands[pl] |= 1ull << trick[pl].id;
+	RoundState by[2] = {RoundState(short_hands, Card::Heart, 0), RoundState(short_hands, Card::Heart, 0)};
+	for (int g = 0; g < 2; g++)
+		for (const auto &trick : grouping[g])
+			for (Card c : trick)
+				by[g].play(c);
+	RoundSnapshot snap{};
+	snap.trump = Card::Heart;
+	snap.turn = snap.opening_player = 0;
+	snap.nbr_tricks = snap.trick_id = 2;
+	snap.team_scores[0] = 2;
+	for (int t = 0; t < 2; t++)
+		for (int pl = 0; pl < Hokm::N_PLAYERS; pl++)
+			snap.plays[t][pl] = grouping[0][t][pl];
+	for (Card &c : snap.table)
+		c = Card::NONE;
+	infoset_ok = infoset_ok && by[0].key == by[1].key && by[0].infoset_key(1) != by[1].infoset_key(1) &&
+				 RoundState(snap).played_key == by[0].played_key;
+
+	std::cout << "RoundState " << sizeof(RoundState) << " bytes; " << nbr_deals
+			  << " random playouts: score mismatches " << bad_score << ", undo mismatches " << bad_undo
+			  << ", key mismatches " << bad_key << "; infoset keys " << (infoset_ok ? "ok" : "wrong") << std::endl;
+	if (bad_score || bad_undo || bad_key || !infoset_ok)
+		throw std::runtime_error("RoundState_test: play/undo disagrees with the reference");
+}
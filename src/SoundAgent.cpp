@@ -7,18 +7,23 @@
 
 #include "SoundAgent.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <string>
 
+#include "binom.h"
 #include "utils.h"
 
-int SoundAgent::s_id = 0;
 
 void SoundAgent::init_round(const Hand &hand) {
 
   this->hand = hand;
 
+  tracker.reset(this->hand.cmpl().bin64, Hokm::N_DELT);
   Habc = this->hand.cmpl();
   Ha = Hb = Hc = Hab = Hbc = Hca = Hand::EMPTY;
   Nu_a = Nu_b = Nu_c = Hokm::N_DELT;
@@ -36,196 +41,53 @@ void SoundAgent::update_oth_hands(int pl_id, const Card &pl_card, Suit led) {
         "SoundAgent::update_oth_hands : pl_c shouldn't be none card");
 #endif
 
-  if ((player_id + 2) % Hokm::N_PLAYERS == pl_id) // c
-  {
-
-    if (!(Habc.remove(pl_card) || Hca.remove(pl_card) || Hbc.remove(pl_card))) {
-      if (!Hc.remove(pl_card))
-        std::cerr << "The card is nowhere! c: " << pl_card.to_string()
-                  << " H: " << (Hc.uni(Hca).uni(Hbc).uni(Habc)).to_string()
-                  << std::endl;
-    }
-    if (led != Card::NON_SU && pl_card.su != led) {
-      Hab.add(Habc.pop(led));
-      Hand h = Hca.pop(led);
-      Ha.add(h);
-      h = Hbc.pop(led);
-      Hb.add(h);
-    }
-  } else if ((player_id + 1) % Hokm::N_PLAYERS == pl_id) // a
-  {
-    if (!(Habc.remove(pl_card) || Hca.remove(pl_card) || Hab.remove(pl_card))) {
-      if (!Ha.remove(pl_card))
-        std::cerr << "The card is nowhere! a: " << pl_card.to_string()
-                  << " H: " << (Ha.uni(Hca).uni(Hab).uni(Habc)).to_string()
-                  << std::endl;
-    }
-    if (led != Card::NON_SU && pl_card.su != led) {
-      Hbc.add(Habc.pop(led));
-      Hand h = Hca.pop(led);
-      Hc.add(h);
-      h = Hab.pop(led);
-      Hb.add(h);
-    }
-  } else // b
-  {
-    if (!(Habc.remove(pl_card) || Hab.remove(pl_card) || Hbc.remove(pl_card))) {
-      if (!Hb.remove(pl_card))
-        std::cerr << "The card is nowhere! b: " << pl_card.to_string()
-                  << " H: " << (Hb.uni(Hbc).uni(Hab).uni(Habc)).to_string()
-                  << std::endl;
-    }
-
-    if (led != Card::NON_SU && pl_card.su != led) {
-      Hca.add(Habc.pop(led));
-      Hand h = Hbc.pop(led);
-      Hc.add(h);
-      h = Hab.pop(led);
-      Ha.add(h);
-    }
-  }
+  // tracker seats: 0 = a, 1 = b, 2 = c
+  const int rel = (pl_id + Hokm::N_PLAYERS - player_id) % Hokm::N_PLAYERS;
+  const int seat = rel == 1 ? 0 : rel == 3 ? 1 : 2;
+  if (!tracker.play(seat, pl_card, led))
+    std::cerr << "The card is nowhere! " << "abc"[seat] << ": "
+              << pl_card.to_string()
+              << " H: " << Hand(tracker.possible(seat)).to_string()
+              << std::endl;
 }
 
 void SoundAgent::updateHandsNcards() {
-  int &Nabc = Habc.nbr_cards;
-  int &Nab = Hab.nbr_cards;
-  int &Nca = Hca.nbr_cards;
-  int &Nbc = Hbc.nbr_cards;
-  int &Na = Ha.nbr_cards;
-  int &Nb = Hb.nbr_cards;
-  int &Nc = Hc.nbr_cards;
-
-  bool changed = false;
-  do {
-    changed = false;
-    if (Ncards_a == Na && (Nabc + Nab + Nca)) {
-      Hbc.add(Habc);
-      Habc.clear();
-      Hb.add(Hab);
-      Hab.clear();
-      Hc.add(Hca);
-      Hca.clear();
-      changed = true;
-    }
-    if (Ncards_b == Nb && (Nabc + Nab + Nbc)) {
-      Hca.add(Habc);
-      Habc.clear();
-      Ha.add(Hab);
-      Hab.clear();
-      Hc.add(Hbc);
-      Hbc.clear();
-      changed = true;
-    }
-    if (Ncards_c == Nc && (Nabc + Nbc + Nca)) {
-      Hab.add(Habc);
-      Habc.clear();
-      Ha.add(Hca);
-      Hca.clear();
-      Hb.add(Hbc);
-      Hbc.clear();
-      changed = true;
-    }
-    if (Ncards_a + Ncards_b == Na + Nb + Nab && (Nabc + Nca + Nbc)) {
-      Hc.add(Habc);
-      Habc.clear();
-      Hc.add(Hca);
-      Hca.clear();
-      Hc.add(Hbc);
-      Hbc.clear();
-      changed = true;
-    }
-    if (Ncards_a + Ncards_c == Na + Nc + Nca && (Nabc + Nab + Nbc)) {
-      Hb.add(Habc);
-      Habc.clear();
-      Hb.add(Hab);
-      Hab.clear();
-      Hb.add(Hbc);
-      Hbc.clear();
-      changed = true;
-    }
-    if (Ncards_b + Ncards_c == Nb + Nc + Nbc && (Nabc + Nab + Nca)) {
-      Ha.add(Habc);
-      Habc.clear();
-      Ha.add(Hab);
-      Hab.clear();
-      Ha.add(Hca);
-      Hca.clear();
-      changed = true;
-    }
-  } while (changed);
+  const CardConstraints cons = tracker.constraints();
+#ifdef DEBUG
+  if (cons.n_a != Ncards_a || cons.n_b != Ncards_b || cons.n_c != Ncards_c)
+    throw std::runtime_error(
+        "SoundAgent::updateHandsNcards : tracker counts off the state's");
+#endif
+  Ha = Hand(cons.a);
+  Hb = Hand(cons.b);
+  Hc = Hand(cons.c);
+  Hab = Hand(cons.ab);
+  Hbc = Hand(cons.bc);
+  Hca = Hand(cons.ca);
+  Habc = Hand(cons.abc);
 }
 
 // -----------------------------------------------------------------------------
 // Numeric helpers
 // -----------------------------------------------------------------------------
-inline long double clamp01l(long double x) {
-  if (x < 0.0L)
-    return 0.0L;
-  if (x > 1.0L)
-    return 1.0L;
+inline double clamp01(double x) {
+  if (x < 0.0)
+    return 0.0;
+  if (x > 1.0)
+    return 1.0;
   return x;
 }
 
-// C(k,n)/C(m,n) with 0 <= n <= k <= m; O(n) stable product; stays in [0,1].
-long double comb_ratio_same_n_product(std::int64_t k, std::int64_t m,
-                                      std::int64_t n) {
+// C(k,n)/C(m,n) with 0 <= n <= k <= m <= 52, from the binomial table; the
+// integers are exact, so the ratio is one rounding away and in [0,1].
+inline double comb_ratio_same_n(int k, int m, int n) {
   if (n < 0 || k < 0 || m < 0)
-    return 0.0L;
-  if (n == 0)
-    return 1.0L;
-  if (k < n || m < n || k > m)
-    return 0.0L;
-  if (k == m)
-    return 1.0L;
-
-  long double prod = 1.0L;
-  for (std::int64_t i = 0; i < n; ++i) {
-    long double num = static_cast<long double>(k - i);
-    long double den = static_cast<long double>(m - i);
-    if (den == 0.0L)
-      return 0.0L;
-    prod *= (num / den);
-    if (prod == 0.0L)
-      break;
-  }
-  return clamp01l(prod);
-}
-
-// log(C(k,n)/C(m,n)) via lgamma; robust for large params (may be slower).
-long double log_comb_ratio_same_n(std::int64_t k, std::int64_t m,
-                                  std::int64_t n) {
-  if (n < 0 || k < 0 || m < 0)
-    return -std::numeric_limits<long double>::infinity();
+    return 0.0;
   if (n == 0)
-    return 0.0L;
-  if (k < n || m < n || k > m)
-    return -std::numeric_limits<long double>::infinity();
-  if (k == m)
-    return 0.0L;
-
-  long double lk =
-      lgammal((long double)k + 1.0L) - lgammal((long double)(k - n) + 1.0L);
-  long double lm =
-      lgammal((long double)m + 1.0L) - lgammal((long double)(m - n) + 1.0L);
-  return lk - lm;
-}
-
-// Wrapper: uses product for typical n, log-domain for very large n.
-long double comb_ratio_same_n(std::int64_t k, std::int64_t m, std::int64_t n) {
-  if (n <= 1000) {
-    return comb_ratio_same_n_product(k, m, n);
-  } else {
-    return clamp01l(expl(log_comb_ratio_same_n(k, m, n)));
-  }
-}
-
-// log binomial C(n,k) via lgamma (for multinomial pieces; avoids overflow).
-inline long double log_nCk_ll(long double n, long double k) {
-  if (k < 0.0L || k > n)
-    return -std::numeric_limits<long double>::infinity();
-  if (k == 0.0L || k == n)
-    return 0.0L;
-  return lgammal(n + 1.0L) - lgammal(k + 1.0L) - lgammal(n - k + 1.0L);
+    return 1.0;
+  if (k < n || k > m)
+    return 0.0;
+  return (double)binom(k, n) / (double)binom(m, n);
 }
 
 // -----------------------------------------------------------------------------
@@ -239,62 +101,39 @@ struct PoolCounts {
   int o_oth = 0;  // others
 };
 
+// From h_o's bitmask: suit masks and the rank threshold above m_c give the
+// five counts as popcounts.
 PoolCounts compute_pool_counts(const Hand &h_o, const Card &m_c, int s_led,
                                int s_tr) {
   PoolCounts pc{};
-  for (int su = 0; su < Card::N_SUITS; ++su) {
-    for (int r = 0; r < Card::N_RANKS; ++r) {
-      Card c{su, r};
-      if (!h_o.is_in(c))
-        continue;
-      ++pc.M;
-      bool is_led = (su == s_led);
-      bool is_tr = (su == s_tr);
-      if (is_led) {
-        ++pc.a_led;
-        if (r > m_c.rnk)
-          ++pc.h_high;
-      } else if (is_tr && s_tr != s_led) {
-        ++pc.t_tr;
-      } else {
-        ++pc.o_oth;
-      }
-    }
-  }
+  const std::uint64_t led = h_o.bin64 & Hand::suit_mask(s_led);
+  pc.M = popcount64(h_o.bin64);
+  pc.a_led = popcount64(led);
+  pc.h_high = popcount64(led & Hand::above_mask(s_led, m_c.rank()));
+  if (s_tr != s_led)
+    pc.t_tr = popcount64(h_o.bin64 & Hand::suit_mask(s_tr));
+  pc.o_oth = pc.M - pc.a_led - pc.t_tr;
   return pc;
 }
 
-// -----------------------------------------------------------------------------
-// Single-opponent exact probability (ord = 1 or 2): opponent beats m_c
-// -----------------------------------------------------------------------------
-double prob_higher_single_exact(const Hand &h_o, const Card &m_c, int s_led,
-                                int s_tr, int n_a) {
-  PoolCounts pc = compute_pool_counts(h_o, m_c, s_led, s_tr);
-  const int M = pc.M;
-  if (n_a <= 0 || M <= 0 || n_a > M)
-    return 0.0;
-
-  if (s_tr == s_led) {
-    // P(E) = 1 - C(M - h, n) / C(M, n)
-    long double p_noH = comb_ratio_same_n(M - pc.h_high, M, n_a);
-    return (double)clamp01l(1.0L - p_noH);
+// The counts for every card of `cands` led in turn, into out[id]: the suit
+// counts are taken once, each card adds one popcount for its higher cards.
+void compute_pool_counts(const Hand &h_o, std::uint64_t cands, int s_tr,
+                         PoolCounts out[Card::N_CARDS]) {
+  const int M = popcount64(h_o.bin64);
+  int len[Card::N_SUITS];
+  for (Suit su = 0; su < Card::N_SUITS; su++)
+    len[su] = h_o.len(su);
+  for (Cid id : BitIter(cands)) {
+    const Card c(id);
+    const Suit su = c.suit();
+    PoolCounts &pc = out[id];
+    pc.M = M;
+    pc.a_led = len[su];
+    pc.h_high = popcount64(h_o.bin64 & Hand::above_mask(su, c.rank()));
+    pc.t_tr = su == s_tr ? 0 : len[s_tr];
+    pc.o_oth = M - pc.a_led - pc.t_tr;
   }
-
-  // s_tr != s_led
-  const int a = pc.a_led;
-  const int h = pc.h_high;
-  const int t = pc.t_tr;
-
-  // P(H) = 1 - C(M - h, n) / C(M, n)
-  long double P_H = 1.0L - comb_ratio_same_n(M - h, M, n_a);
-
-  // P(¬L ∧ T) = [C(M - a, n) - C(M - a - t, n)] / C(M, n)
-  long double p_notL = comb_ratio_same_n(M - a, M, n_a);
-  long double p_notL_notT = comb_ratio_same_n(M - a - t, M, n_a);
-  long double P_notL_T = clamp01l(p_notL - p_notL_notT);
-
-  long double P = P_H + P_notL_T;
-  return (double)clamp01l(P);
 }
 
 // -----------------------------------------------------------------------------
@@ -303,37 +142,36 @@ double prob_higher_single_exact(const Hand &h_o, const Card &m_c, int s_led,
 //  - no higher led-suit
 //  - and [has at least one led-low OR (no led AND no trump)]
 // -----------------------------------------------------------------------------
-long double prob_b_fail_given_rem(int h_rem, int aL_rem, int t_rem, int o_rem,
-                                  int n_b) {
+double prob_b_fail_given_rem(int h_rem, int aL_rem, int t_rem, int o_rem,
+                             int n_b) {
   int Mr = h_rem + aL_rem + t_rem + o_rem;
   if (n_b < 0 || n_b > Mr)
-    return 0.0L;
+    return 0.0;
   if (n_b == 0)
-    return 1.0L;
+    return 1.0;
 
   // No higher led-suit
-  long double p_noH = comb_ratio_same_n(Mr - h_rem, Mr, n_b);
-  if (p_noH == 0.0L)
-    return 0.0L;
+  double p_noH = comb_ratio_same_n(Mr - h_rem, Mr, n_b);
+  if (p_noH == 0.0)
+    return 0.0;
 
   int M_noH = Mr - h_rem;
   // Within no-high pool: aL, t, o are available
-  long double p_al_ge1 = 1.0L - comb_ratio_same_n(t_rem + o_rem, M_noH, n_b);
-  long double p_all_o = comb_ratio_same_n(o_rem, M_noH, n_b);
+  double p_al_ge1 = 1.0 - comb_ratio_same_n(t_rem + o_rem, M_noH, n_b);
+  double p_all_o = comb_ratio_same_n(o_rem, M_noH, n_b);
 
-  long double p_fail_noH = clamp01l(p_al_ge1 + p_all_o);
-  return clamp01l(p_noH * p_fail_noH);
+  double p_fail_noH = clamp01(p_al_ge1 + p_all_o);
+  return clamp01(p_noH * p_fail_noH);
 }
 
 // -----------------------------------------------------------------------------
 // Two-opponent exact probability (ord = 0): you lead; any opponent beats
-// n_a: cards that opponent a draws from pool h_o
+// n_a: cards that opponent a draws from the pool
 // n_b: cards that opponent b draws from the remaining pool
+// It depends on the pool through its counts only; same_suit: trump was led.
 // -----------------------------------------------------------------------------
-double prob_higher_ord0_exact(const Hand &h_o, const Card &m_c, int s_tr,
-                              int n_a, int n_b) {
-  const int s_led = m_c.su;
-  PoolCounts pc = compute_pool_counts(h_o, m_c, s_led, s_tr);
+double prob_higher_ord0_counts(const PoolCounts &pc, bool same_suit, int n_a,
+                               int n_b) {
   const int M = pc.M;
   if (n_a < 0 || n_b < 0 || n_a + n_b > M)
     return 0.0;
@@ -341,13 +179,12 @@ double prob_higher_ord0_exact(const Hand &h_o, const Card &m_c, int s_tr,
   if (n_a == 0 && n_b == 0)
     return 0.0;
 
-  // s_tr == s_led: "beats" == "has a higher led-suit"
-  if (s_tr == s_led) {
-    long double pA_noH = comb_ratio_same_n(M - pc.h_high, M, n_a);
-    long double pB_noH_givenA =
+  // trump led: "beats" == "has a higher led-suit"
+  if (same_suit) {
+    double pA_noH = comb_ratio_same_n(M - pc.h_high, M, n_a);
+    double pB_noH_givenA =
         comb_ratio_same_n((M - n_a) - pc.h_high, (M - n_a), n_b);
-    long double P_any = 1.0L - clamp01l(pA_noH * pB_noH_givenA);
-    return (double)clamp01l(P_any);
+    return clamp01(1.0 - clamp01(pA_noH * pB_noH_givenA));
   }
 
   // s_tr != s_led
@@ -357,8 +194,8 @@ double prob_higher_ord0_exact(const Hand &h_o, const Card &m_c, int s_tr,
   const int o = pc.o_oth;
 
   // Sum over a's failing selections (no high, and [al>=1 or (al=0 & t=0)])
-  long double log_den_A = log_nCk_ll((long double)M, (long double)n_a);
-  long double P_both_fail = 0.0L;
+  const double den_A = (double)binom(M, n_a);
+  double P_both_fail = 0.0;
 
   for (int al_a = 0; al_a <= std::min(aL, n_a); ++al_a) {
     int rem_after_al = n_a - al_a;
@@ -373,12 +210,11 @@ double prob_higher_ord0_exact(const Hand &h_o, const Card &m_c, int s_tr,
         continue; // al=0 and t>=1 -> would beat
 
       // Probability of this exact (al_a, t_a, o_a) for a (no restriction on
-      // order)
-      long double log_num = log_nCk_ll((long double)aL, (long double)al_a) +
-                            log_nCk_ll((long double)t, (long double)t_a) +
-                            log_nCk_ll((long double)o, (long double)o_a);
-      long double pA_this = expl(log_num - log_den_A);
-      if (pA_this == 0.0L)
+      // order); the product counts some of the C(M, n_a) hands, so it is
+      // exact in 64 bits
+      double pA_this =
+          (double)(binom(aL, al_a) * binom(t, t_a) * binom(o, o_a)) / den_A;
+      if (pA_this == 0.0)
         continue;
 
       // Remaining counts for b (h remains since a had no high)
@@ -387,29 +223,252 @@ double prob_higher_ord0_exact(const Hand &h_o, const Card &m_c, int s_tr,
       int t_rem = t - t_a;
       int o_rem = o - o_a;
 
-      long double pB_fail =
-          prob_b_fail_given_rem(h_rem, aL_rem, t_rem, o_rem, n_b);
-      if (pB_fail == 0.0L)
+      double pB_fail = prob_b_fail_given_rem(h_rem, aL_rem, t_rem, o_rem, n_b);
+      if (pB_fail == 0.0)
         continue;
 
       P_both_fail += pA_this * pB_fail;
     }
   }
 
-  long double P_any = 1.0L - clamp01l(P_both_fail);
-  return (double)clamp01l(P_any);
+  return clamp01(1.0 - clamp01(P_both_fail));
 }
 
 // -----------------------------------------------------------------------------
-// Convenience wrappers (ord 1 and ord 2 are identical structurally)
+// Memo of prob_higher_ord0_counts shared by every agent and thread. The key
+// (trump led, M, a_led, h_high, t_tr, n_a, n_b) takes 27 bits and fixes o_oth;
+// a slot is one 64-bit word holding the key and the probability in 33-bit
+// fixed point (0 and 1 exact), so a load sees a whole entry and needs no lock.
+// Slots are direct-mapped and a colliding key simply overwrites. Every result
+// goes through the fixed point, hit or miss, so play does not depend on what
+// the cache happens to hold.
 // -----------------------------------------------------------------------------
-double prob_higher_ord1_exact(const Hand &h_o, const Card &m_c, int s_led,
-                              int s_tr, int n_a) {
-  return prob_higher_single_exact(h_o, m_c, s_led, s_tr, n_a);
+class ProbMemo {
+public:
+  double get(const PoolCounts &pc, bool same_suit, int n_a, int n_b) {
+    if (pc.M >= 64 || pc.a_led >= 16 || pc.t_tr >= 16 || n_a < 0 ||
+        n_a >= 16 || n_b < 0 || n_b >= 16)
+      return prob_higher_ord0_counts(pc, same_suit, n_a, n_b);
+    const std::uint64_t key =
+        std::uint64_t(same_suit) | std::uint64_t(pc.M) << 1 |
+        std::uint64_t(pc.a_led) << 7 | std::uint64_t(pc.h_high) << 11 |
+        std::uint64_t(pc.t_tr) << 15 | std::uint64_t(n_a) << 19 |
+        std::uint64_t(n_b) << 23;
+    std::atomic<std::uint64_t> &slot =
+        slots[(key * 0x9E3779B97F4A7C15ull) >> (64 - LOG2_SLOTS)];
+    const std::uint64_t entry = slot.load(std::memory_order_relaxed);
+    if ((entry & KEY_MASK) == (key << 1 | 1))
+      return std::ldexp(double(entry >> VALUE_SHIFT), -32);
+    const double p = prob_higher_ord0_counts(pc, same_suit, n_a, n_b);
+    const std::uint64_t fixed = std::uint64_t(std::llround(std::ldexp(p, 32)));
+    slot.store(fixed << VALUE_SHIFT | key << 1 | 1, std::memory_order_relaxed);
+    return std::ldexp(double(fixed), -32);
+  }
+
+private:
+  static constexpr int LOG2_SLOTS = 16;
+  static constexpr int VALUE_SHIFT = 28; // below: key and the in-use bit
+  static constexpr std::uint64_t KEY_MASK = (1ull << VALUE_SHIFT) - 1;
+  std::atomic<std::uint64_t> slots[1 << LOG2_SLOTS]{};
+};
+
+ProbMemo prob_memo;
+
+// -----------------------------------------------------------------------------
+// Leading for later, when no lead is likely to hold now: for each suit s but
+// trump that we hold, the chance that no opponent beats our top of s once the
+// pool's top k cards of s are gone, for k = 1 .. len(s) - 1, up to the first
+// above `floor`. It goes to our bottom card of s in `out`; the cards that got
+// one are returned. The top k of s are also the pool's top k above our card,
+// so the peeled pools are counted, not built. Cards peeled in a suit stay out
+// of the pool for the suits after it.
+// -----------------------------------------------------------------------------
+Hand prob_hold_after_peel(const Hand &hand, Hand pool, Suit trump, int n_a,
+                          int n_b, double floor, ProbHand &out) {
+  Hand found;
+  for (Suit s = 0; s < Card::N_SUITS; s++) {
+    if (s == trump || !hand.len(s))
+      continue;
+    const PoolCounts pc0 = compute_pool_counts(pool, hand.top(s), s, trump);
+    int k = 1;
+    for (; k < hand.len(s); k++) {
+      PoolCounts pc = pc0;
+      pc.a_led = std::max(pc0.a_led - k, 0);
+      pc.h_high = std::max(pc0.h_high - k, 0);
+      pc.M -= pc0.a_led - pc.a_led;
+      const double prb = 1 - prob_memo.get(pc, false, n_a, n_b);
+      if (prb > floor) {
+        out.update(hand.bottom(s), prb);
+        found.add(hand.bottom(s));
+        break;
+      }
+    }
+    pool.rm_top(s, std::min(k, hand.len(s) - 1));
+  }
+  return found;
+}
+
+// -----------------------------------------------------------------------------
+// Exact chances over the deals consistent with the sets and counts: the
+// fraction of deals where a seat holds none of a set is
+// count(exclude(...)) / nbr_worlds, and the events below are sums of those.
+// -----------------------------------------------------------------------------
+CardConstraints SoundAgent::constraints() const {
+  return CardConstraints{Ha.bin64,  Hb.bin64,  Hc.bin64, Hab.bin64,
+                         Hbc.bin64, Hca.bin64, Habc.bin64, Ncards_a,
+                         Ncards_b,  Ncards_c};
+}
+
+void SoundAgent::updateProbs() {
+  nbr_worlds = DealSampler::count(constraints());
+}
+
+double SoundAgent::prob_a_beats(const Card &m_c, Suit led,
+                                Suit trump) const {
+  if (nbr_worlds == 0)
+    return 1;
+  const CardConstraints cons = constraints();
+  auto none = [&](std::uint64_t s_a) {
+    return (std::int64_t)DealSampler::count(DealSampler::exclude(cons, s_a, 0));
+  };
+  const std::uint64_t L = Hand::suit_mask(led);
+  const std::uint64_t T = trump == led ? 0 : Hand::suit_mask(trump);
+  if (m_c.suit() == led) {
+    // a fails with no higher led card, and with no led card also no trump.
+    std::int64_t fail = none(Hand::above_mask(led, m_c.rank()));
+    if (T)
+      fail += none(L | T) - none(L);
+    return 1 - (double)fail / nbr_worlds;
+  }
+  if (m_c.suit() == trump) // our ruff: a is void in led with a higher trump
+    return (double)(none(L) - none(L | Hand::above_mask(trump, m_c.rank()))) /
+           nbr_worlds;
+  return 1;
+}
+
+double SoundAgent::prob_ab_beat_lead(const Card &m_c, Suit trump) const {
+  if (nbr_worlds == 0)
+    return 1;
+  const CardConstraints cons = constraints();
+  auto none = [&](std::uint64_t s_a, std::uint64_t s_b) {
+    return (std::int64_t)DealSampler::count(
+        DealSampler::exclude(cons, s_a, s_b));
+  };
+  const Suit led = m_c.suit();
+  const std::uint64_t H = Hand::above_mask(led, m_c.rank());
+  if (led == trump)
+    return 1 - (double)none(H, H) / nbr_worlds;
+  // Each of a and b fails iff it lacks H, minus lacking L, plus lacking L and
+  // T; both failing is the product of the two sums expanded.
+  const std::uint64_t L = Hand::suit_mask(led);
+  const std::uint64_t S[3] = {H, L, L | Hand::suit_mask(trump)};
+  const int sign[3] = {1, -1, 1};
+  std::int64_t fail = 0;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      fail += sign[i] * sign[j] * none(S[i], S[j]);
+  return 1 - (double)fail / nbr_worlds;
+}
+
+// The batches below take the deal counts that do not depend on the card once
+// per suit; cards with no unseen card between them share the rest.
+void SoundAgent::probs_a_fails(std::uint64_t cands, Suit led, Suit trump,
+                               ProbHand &out) const {
+  if (nbr_worlds == 0) {
+    out.update(Hand(cands), 0);
+    return;
+  }
+  const CardConstraints cons = constraints();
+  const std::uint64_t unseen = Ha.bin64 | Hb.bin64 | Hc.bin64 | Hab.bin64 |
+                               Hbc.bin64 | Hca.bin64 | Habc.bin64;
+  auto none = [&](std::uint64_t s_a) {
+    return (std::int64_t)DealSampler::count(DealSampler::exclude(cons, s_a, 0));
+  };
+  const std::uint64_t L = Hand::suit_mask(led);
+  const std::uint64_t T = trump == led ? 0 : Hand::suit_mask(trump);
+  const std::int64_t none_L = (cands & (L | T)) ? none(L) : 0;
+  const std::int64_t void_fail = T && (cands & L) ? none(L | T) - none_L : 0;
+  out.update(Hand(cands & ~(L | T)), 0);
+  std::uint64_t last_H = ~0ull;
+  double last_prb = 0;
+  for (Cid id : BitIter(cands & (L | T))) {
+    const Card c(id);
+    const std::uint64_t H = Hand::above_mask(c.suit(), c.rank()) & unseen;
+    if (H != last_H) {
+      const double beat =
+          c.suit() == led
+              ? 1 - (double)(none(H) + void_fail) / nbr_worlds
+              : (double)(none_L - none(L | H)) / nbr_worlds;
+      last_H = H;
+      last_prb = 1 - beat;
+    }
+    out.update(c, last_prb);
+  }
 }
-double prob_higher_ord2_exact(const Hand &h_o, const Card &m_c, int s_led,
-                              int s_tr, int n_a) {
-  return prob_higher_single_exact(h_o, m_c, s_led, s_tr, n_a);
+
+void SoundAgent::probs_ab_fail_lead(std::uint64_t cands, Suit trump,
+                                    ProbHand &out) const {
+  if (nbr_worlds == 0) {
+    out.update(Hand(cands), 0);
+    return;
+  }
+  const CardConstraints cons = constraints();
+  const std::uint64_t unseen = Ha.bin64 | Hb.bin64 | Hc.bin64 | Hab.bin64 |
+                               Hbc.bin64 | Hca.bin64 | Habc.bin64;
+  auto none = [&](std::uint64_t s_a, std::uint64_t s_b) {
+    return (std::int64_t)DealSampler::count(
+        DealSampler::exclude(cons, s_a, s_b));
+  };
+  for (Suit led = 0; led < Card::N_SUITS; led++) {
+    const std::uint64_t in_suit = cands & Hand::suit_mask(led);
+    if (!in_suit)
+      continue;
+    // the four terms of prob_ab_beat_lead's expansion without H
+    const std::uint64_t L = Hand::suit_mask(led);
+    const std::uint64_t LT = L | Hand::suit_mask(trump);
+    const std::int64_t no_H =
+        led == trump ? 0
+                     : none(L, L) - none(L, LT) - none(LT, L) + none(LT, LT);
+    std::uint64_t last_H = ~0ull;
+    double last_prb = 0;
+    for (Cid id : BitIter(in_suit)) {
+      const Card c(id);
+      const std::uint64_t H = Hand::above_mask(led, c.rank()) & unseen;
+      if (H != last_H) {
+        std::int64_t fail = none(H, H);
+        if (led != trump)
+          fail += no_H - none(H, L) + none(H, LT) - none(L, H) + none(LT, H);
+        const double beat = 1 - (double)fail / nbr_worlds;
+        last_H = H;
+        last_prb = 1 - beat;
+      }
+      out.update(c, last_prb);
+    }
+  }
+}
+
+RoundState
+SoundAgent::determinize(const State &state, const std::uint64_t oth[3],
+                        const std::array<int, Hokm::N_TEAMS> &scores) const {
+  const int leader =
+      (player_id + Hokm::N_PLAYERS - state.ord) % Hokm::N_PLAYERS;
+  std::uint64_t hands[Hokm::N_PLAYERS];
+  hands[player_id] = hand.bin64;
+  hands[(player_id + 1) % Hokm::N_PLAYERS] = oth[0];
+  hands[(player_id + 3) % Hokm::N_PLAYERS] = oth[1];
+  hands[(player_id + 2) % Hokm::N_PLAYERS] = oth[2];
+  for (int o = 0; o < state.ord; o++) {
+    const int pl = (leader + o) % Hokm::N_PLAYERS;
+    hands[pl] |= 1ull << state.table[pl].id;
+  }
+  RoundState st(hands, state.trump, leader);
+  st.trick_id = state.trick_id;
+  for (int team = 0; team < Hokm::N_TEAMS; team++)
+    st.team_scores[team] = scores[team];
+  st.key = st.compute_key();
+  for (int o = 0; o < state.ord; o++)
+    st.play(state.table[(leader + o) % Hokm::N_PLAYERS]);
+  return st;
 }
 
 Suit SoundAgent::call_trump(const CardStack &first_5cards) {
@@ -420,14 +479,12 @@ Suit SoundAgent::call_trump(const CardStack &first_5cards) {
 
   double scr[Card::N_SUITS];
   //   float beta = 1.0f / 6;
-  Card c;
   for (Suit su = 0; su < Card::N_SUITS; su++) {
+    PoolCounts pc[Card::N_CARDS];
+    compute_pool_counts(cmpHand, hand.bin64, su, pc);
     double sum_r = 0;
-    for (int s = 0; s < Card::N_SUITS; s++)
-      for (int i = 0; i < hand.len[s]; i++)
-        sum_r += 1 - prob_higher_ord0_exact(cmpHand, c.set(s, hand.cards[s][i]),
-                                            su, 13, 13);
-    //   sum_r += hand.cards[s][i];
+    for (Cid id : BitIter(hand.bin64))
+      sum_r += 1 - prob_memo.get(pc[id], Card(id).suit() == su, 13, 13);
     scr[su] = sum_r;
   }
 
@@ -439,34 +496,22 @@ Suit SoundAgent::call_trump(const CardStack &first_5cards) {
     if (scr[t] > max_scr) {
       max_scr = scr[t];
       trump = t;
-    } else if (scr[t] == max_scr && hand.len[t] < hand.len[trump])
+    } else if (scr[t] == max_scr && hand.len(t) < hand.len(trump))
       trump = t;
   }
   LOG(name << ", alg. trump: " << Card::SU_STR[trump]);
   //	if (trump == Card::NON_SU)
   //		return first_5cards.at(
   //				std::uniform_int_distribution<int>(0,
-  // 4)(mt_rnd_gen)).su;
+  // 4)(mt_rnd_gen)).suit();
   return trump;
 }
 
-Card SoundAgent::act(const State &state, const History &hist) {
-  int op_team = (team_id + 1) % Hokm::N_TEAMS;
-  LOG("--- " << name << " pl_id " << player_id << " team " << team_id << " ord "
-             << (int)state.ord << " last_ord " << last_ord << " last_led "
-             << Card::SU_STR[last_led] << " led " << Card::SU_STR[state.led]
-             << " trump " << Card::SU_STR[state.trump] << " trick_id "
-             << state.trick_id << "\nhand: " << hand.to_string());
-
+void SoundAgent::observe(const State &state, const History &hist) {
   int b_id = (player_id + 3) % 4;
   int c_id = (player_id + 2) % 4;
   int a_id = (player_id + 1) % 4;
 
-  bool critical =
-      state.score[op_team] >= (Hokm::RND_WIN_SCORE - 2) ||
-      state.score[op_team] > state.score[team_id] + Hokm::RND_WIN_SCORE / 2;
-  LOG("critical: " << critical);
-
   Card c;
   switch (last_ord) {
   case -1:
@@ -515,9 +560,9 @@ Card SoundAgent::act(const State &state, const History &hist) {
     Ncards_b--;
   }
   updateHandsNcards();
-  Nu_a = Ncards_a - Ha.nbr_cards;
-  Nu_b = Ncards_b - Hb.nbr_cards;
-  Nu_c = Ncards_c - Hc.nbr_cards;
+  Nu_a = Ncards_a - Ha.nbr_cards();
+  Nu_b = Ncards_b - Hb.nbr_cards();
+  Nu_c = Ncards_c - Hc.nbr_cards();
   LOG("Habc: " << Habc.to_string());
   LOG("Hab: " << Hab.to_string());
   LOG("Hca: " << Hca.to_string());
@@ -528,22 +573,35 @@ Card SoundAgent::act(const State &state, const History &hist) {
   LOG("Nu_a: " << Nu_a << ", Nu_b: " << Nu_b << ", Nu_c: " << Nu_c);
   LOG("Ncards_a: " << Ncards_a << " Ncards_b: " << Ncards_b
                    << " Ncards_c: " << Ncards_c);
-  //   updateProbs();
-  //   LOG("Pa.nbr: " << Pa.nbr() << ", Pb.nbr: " << Pb.nbr()
-  //                  << ", Pc.nbr: " << Pc.nbr());
-  //   LOG("Pa: " << Pa.to_string());
-  //   LOG("Pb: " << Pb.to_string());
-  //   LOG("Pc: " << Pc.to_string());
-  // #ifdef DEBUG
-  //   if (Pa.nbr() != Ncards_a || Pb.nbr() != Ncards_b || Pc.nbr() !=
-  //   Ncards_c)
-  //   {
-  //     throw std::runtime_error("Nbr of cards inconsistencies!");
-  //   }
-  // #endif
+  updateProbs();
+  LOG("nbr_worlds: " << nbr_worlds);
+#ifdef DEBUG
+  if (nbr_worlds == 0)
+    throw std::runtime_error("Nbr of cards inconsistencies!");
+#endif
 
   last_ord = state.ord;
   last_led = state.led;
+}
+
+Card SoundAgent::act(const State &state, const History &hist) {
+  int op_team = (team_id + 1) % Hokm::N_TEAMS;
+  LOG("--- " << name << " pl_id " << player_id << " team " << team_id << " ord "
+             << (int)state.ord << " last_ord " << last_ord << " last_led "
+             << Card::SU_STR[last_led] << " led " << Card::SU_STR[state.led]
+             << " trump " << Card::SU_STR[state.trump] << " trick_id "
+             << state.trick_id << "\nhand: " << hand.to_string());
+
+  int b_id = (player_id + 3) % 4;
+  int c_id = (player_id + 2) % 4;
+  int a_id = (player_id + 1) % 4;
+
+  bool critical =
+      state.score[op_team] >= (Hokm::RND_WIN_SCORE - 2) ||
+      state.score[op_team] > state.score[team_id] + Hokm::RND_WIN_SCORE / 2;
+  LOG("critical: " << critical);
+
+  observe(state, hist);
 
   const Card &a_card = state.table[a_id];
   const Card &b_card = state.table[b_id];
@@ -563,28 +621,20 @@ Card SoundAgent::act(const State &state, const History &hist) {
     Hand H_ab = Hab.uni(Ha).uni(Hb);
     Hand ps_hi = hand.lead_gt(H_ab, Card::NON_SU, state.trump);
     LOG("pssbl_hi_hand: " << ps_hi.to_string());
-    if (ps_hi.nbr_cards == 0) {
+    if (ps_hi.nbr_cards() == 0) {
+      ProbHand peel;
+      Hand later = prob_hold_after_peel(hand, ps_ab, state.trump, Nu_a, Nu_b,
+                                        this->prob_floor, peel);
       double prb_m = 0;
-      for (Suit s = 0; s < Card::N_SUITS; s++)
-        if (s != state.trump && hand.len[s]) {
-          Card c_max = hand.top(s);
-          int ls = hand.len[s] - 1;
-          while (ls > 0) {
-            ps_ab.rm_top(s, 1);
-            double prb = 1 - prob_higher_ord0_exact(ps_ab, c_max, state.trump,
-                                                    Nu_a, Nu_b);
-            if (prb > this->prob_floor) {
-              if (prb > prb_m) {
-                ps_play.clear();
-                prb_m = prb;
-                ps_play.add(hand.bottom(s));
-              } else if (prb == prb_m)
-                ps_play.add(hand.bottom(s));
-              break;
-            }
-            ls--;
-          }
-        }
+      for (Cid id : BitIter(later.bin64)) {
+        double prb = peel.getProb(Card(id));
+        if (prb > prb_m) {
+          ps_play.clear();
+          prb_m = prb;
+          ps_play.add(Card(id));
+        } else if (prb == prb_m)
+          ps_play.add(Card(id));
+      }
       LOG("No-hi-hand, pssbl. for the future: " << ps_play.to_string()
                                                 << ", prb_m " << prb_m);
       Hand *h = (prb_m > 0) ? &ps_play : &hand;
@@ -592,41 +642,24 @@ Card SoundAgent::act(const State &state, const History &hist) {
       break;
     }
     ProbHand ps_prb_play;
-    Card c;
-    for (Suit s = 0; s < Card::N_SUITS; s++) {
-      for (int i = 0; i < ps_hi.len[s]; i++) {
-        c.set(s, ps_hi.cards[s][i]);
-        double prb =
-            1 - prob_higher_ord0_exact(ps_ab, c, state.trump, Nu_a, Nu_b);
-        LOG("Card " << c.to_string() << ", prob: " << prb << " / "
-                    << prob_floor);
-        ps_prb_play.update(c, prb);
-      }
-    }
+    probs_ab_fail_lead(ps_hi.bin64, state.trump, ps_prb_play);
+    LOG("Probs. / " << prob_floor << ": " << ps_prb_play.to_string());
     ps_play = ps_prb_play.gt(this->prob_floor);
     LOG("Psbl. play: " << ps_play.to_string());
-    if (ps_play.nbr_cards == 0) {
+    if (ps_play.nbr_cards() == 0) {
+      ProbHand peel;
+      Hand later = prob_hold_after_peel(hand, ps_ab, state.trump, Nu_a, Nu_b,
+                                        this->prob_floor, peel);
       double prb_m = 0;
-      for (Suit s = 0; s < Card::N_SUITS; s++)
-        if (s != state.trump && hand.len[s]) {
-          Card c_max = hand.top(s);
-          int ls = hand.len[s] - 1;
-          while (ls > 0) {
-            ps_ab.rm_top(s, 1);
-            double prb = 1 - prob_higher_ord0_exact(ps_ab, c_max, state.trump,
-                                                    Nu_a, Nu_b);
-            if (prb > this->prob_floor) {
-              if (prb > prb_m) {
-                ps_play.clear();
-                prb_m = prb;
-                ps_play.add(hand.bottom(s));
-              } else if (prb == prb_m)
-                ps_play.add(hand.bottom(s));
-              break;
-            }
-            ls--;
-          }
-        }
+      for (Cid id : BitIter(later.bin64)) {
+        double prb = peel.getProb(Card(id));
+        if (prb > prb_m) {
+          ps_play.clear();
+          prb_m = prb;
+          ps_play.add(Card(id));
+        } else if (prb == prb_m)
+          ps_play.add(Card(id));
+      }
       LOG("No-hi-prob, pssbl. for the future: " << ps_play.to_string()
                                                 << ", prb_m " << prb_m);
       Hand *h = (prb_m > 0) ? &ps_play : &hand;
@@ -635,9 +668,9 @@ Card SoundAgent::act(const State &state, const History &hist) {
     }
     Hand cert_h = ps_prb_play.gte(1.0).discard(state.trump);
     LOG("Cert hand: " << cert_h.to_string());
-    Hand *h = (cert_h.nbr_cards) ? &cert_h : &ps_play;
+    Hand *h = (cert_h.nbr_cards()) ? &cert_h : &ps_play;
     out = h->min_mil_trl(state.led, state.trump);
-    if (out.su == state.trump && state.led != state.trump) {
+    if (out.suit() == state.trump && state.led != state.trump) {
       out = ps_prb_play.gt(this->prob_floor - 0.15)
                 .min_mil_trl(state.led, state.trump);
     }
@@ -652,34 +685,24 @@ Card SoundAgent::act(const State &state, const History &hist) {
     H_a.add(b_card);
     Hand ps_hi = hand.lead_gt(H_a, state.led, state.trump);
     LOG("pssbl_hi_hand: " << ps_hi.to_string());
-    if (ps_hi.nbr_cards == 0) {
+    if (ps_hi.nbr_cards() == 0) {
       out = hand.min_mil_trl(state.led, state.trump);
       break;
     }
     ProbHand ps_prb_play;
-    Hand ps_a = Habc.uni(Hca).uni(Hab);
-    Card c;
-    for (Suit s = 0; s < Card::N_SUITS; s++) {
-      for (int i = 0; i < ps_hi.len[s]; i++) {
-        c.set(s, ps_hi.cards[s][i]);
-        double prb =
-            1 - prob_higher_ord1_exact(ps_a, c, state.led, state.trump, Nu_a);
-        LOG("Card " << c.to_string() << ", prob: " << prb << " / "
-                    << prob_floor);
-        ps_prb_play.update(c, prb);
-      }
-    }
+    probs_a_fails(ps_hi.bin64, state.led, state.trump, ps_prb_play);
+    LOG("Probs. / " << prob_floor << ": " << ps_prb_play.to_string());
     Hand ps_play = ps_prb_play.gt(this->prob_floor);
     LOG("Psbl. play: " << ps_play.to_string());
-    if (ps_play.nbr_cards == 0) {
+    if (ps_play.nbr_cards() == 0) {
       out = hand.min_mil_trl(state.led, state.trump);
       break;
     }
     Hand cert_h = ps_prb_play.gte(1.0).discard(state.trump);
     LOG("Cert hand: " << cert_h.to_string());
-    Hand *h = (cert_h.nbr_cards) ? &cert_h : &ps_play;
+    Hand *h = (cert_h.nbr_cards()) ? &cert_h : &ps_play;
     out = h->min_mil_trl(state.led, state.trump);
-    if (out.su == state.trump && state.led != state.trump) {
+    if (out.suit() == state.trump && state.led != state.trump) {
       out = ps_prb_play.gt(this->prob_floor - 0.15)
                 .min_mil_trl(state.led, state.trump);
     }
@@ -691,8 +714,7 @@ Card SoundAgent::act(const State &state, const History &hist) {
            c_card != Card::NONE);
     Hand ps_a = Habc.uni(Hca).uni(Hab);
     if (Card::cmp(c_card, b_card, state.led, state.trump) > 0) {
-      double pr_comp_na = 1 - prob_higher_ord2_exact(ps_a, c_card, state.led,
-                                                     state.trump, Nu_a);
+      double pr_comp_na = 1 - prob_a_beats(c_card, state.led, state.trump);
       LOG("comp c " << c_card.to_string() << ", prob. to be better than ps_a: "
                     << pr_comp_na << ", critical: " << critical);
       if (!critical && pr_comp_na > this->prob_floor) {
@@ -707,27 +729,18 @@ Card SoundAgent::act(const State &state, const History &hist) {
     H_a.add(b_card);
     Hand ps_hi = hand.lead_gt(H_a, state.led, state.trump);
     LOG("pssbl_hi_hand: " << ps_hi.to_string());
-    if (ps_hi.nbr_cards == 0) {
+    if (ps_hi.nbr_cards() == 0) {
       out = hand.maxLed_maxTr_min_mil(state.led, state.trump);
       if (Card::cmp(b_card, out, state.led, state.trump) > 0)
         out = hand.min_mil_trl(state.led, state.trump);
       break;
     }
     ProbHand ps_prb_play;
-    Card c;
-    for (Suit s = 0; s < Card::N_SUITS; s++) {
-      for (int i = 0; i < ps_hi.len[s]; i++) {
-        c.set(s, ps_hi.cards[s][i]);
-        double prb =
-            1 - prob_higher_ord2_exact(ps_a, c, state.led, state.trump, Nu_a);
-        LOG("Card " << c.to_string() << ", prob: " << prb << " / "
-                    << prob_floor);
-        ps_prb_play.update(c, prb);
-      }
-    }
+    probs_a_fails(ps_hi.bin64, state.led, state.trump, ps_prb_play);
+    LOG("Probs. / " << prob_floor << ": " << ps_prb_play.to_string());
     Hand ps_play = ps_prb_play.gt(this->prob_floor);
     LOG("Pssbl. play: " << ps_play.to_string());
-    if (ps_play.nbr_cards == 0) {
+    if (ps_play.nbr_cards() == 0) {
       out = hand.maxLed_maxTr_min_mil(state.led, state.trump);
       if (Card::cmp(b_card, out, state.led, state.trump) > 0)
         out = hand.min_mil_trl(state.led, state.trump);
@@ -735,11 +748,11 @@ Card SoundAgent::act(const State &state, const History &hist) {
     }
     Hand cert_h = ps_prb_play.gte(1.0).discard(state.trump);
     LOG("Cert hand: " << cert_h.to_string());
-    if (cert_h.nbr_cards) {
+    if (cert_h.nbr_cards()) {
       out = cert_h.min_mil_trl(state.led, state.trump);
     } else {
       out = ps_play.min_mil_trl(state.led, state.trump);
-      if (out.su == state.trump && state.led != state.trump) {
+      if (out.suit() == state.trump && state.led != state.trump) {
         out = ps_prb_play.gt(this->prob_floor - 0.15)
                   .min_mil_trl(state.led, state.trump);
       }
@@ -747,7 +760,7 @@ Card SoundAgent::act(const State &state, const History &hist) {
     H_a.add(ps_a);
     int dfn = H_a.diff_between(out, c_card);
     LOG("diff " << c_card.to_string() << "-" << out.to_string() << ": " << dfn);
-    if ((out.su != state.trump || c_card.su == state.trump) && dfn >= 0) {
+    if ((out.suit() != state.trump || c_card.suit() == state.trump) && dfn >= 0) {
       LOG("Companion's card is good enough.");
       out = hand.min_mil_trl(state.led, state.trump);
     }
@@ -765,7 +778,7 @@ Card SoundAgent::act(const State &state, const History &hist) {
     }
     Hand hi_hand = hand.gt_c_led(bst_op, state.led, state.trump);
     LOG("hi_hand: " << hi_hand.to_string());
-    if (hi_hand.nbr_cards) {
+    if (hi_hand.nbr_cards()) {
       out = hi_hand.min_mil_trl(state.led, state.trump);
     } else
       out = hand.min_mil_trl(state.led, state.trump);
@@ -773,20 +786,23 @@ Card SoundAgent::act(const State &state, const History &hist) {
   default:
     throw std::logic_error("Shouldn't be here!");
   }
-  hand.remove(out);
+  record_play(out);
   LOG("--- " << name << ", out card: " << out.to_string()
              << ", led: " << Card::SU_STR[state.led]
              << ", trump: " << Card::SU_STR[state.trump]);
-  if (last_led == Card::NON_SU)
-    last_led = out.su;
   return out;
 }
 
+void SoundAgent::record_play(const Card &out) {
+  hand.remove(out);
+  if (last_led == Card::NON_SU)
+    last_led = out.suit();
+}
+
 SoundAgent::SoundAgent(double min_prob, double trump_prb_cap, double max_prob)
-    : Agent(), mt_rnd_gen(std::mt19937(std::random_device()())),
-      prob_floor(min_prob), trump_prob_cap(trump_prb_cap),
+    : Agent(), prob_floor(min_prob), trump_prob_cap(trump_prb_cap),
       prob_ceiling(max_prob) {
-  name = "AI_S" + std::to_string(s_id++);
+  name = name_tag = "AI_S";
 }
 
 void SoundAgent::set_probs(double prob_floor, double trump_prob_cap,
@@ -801,6 +817,7 @@ void SoundAgent::set_probs(double prob_floor, double trump_prob_cap,
 
 void SoundAgent::reset() {
 
+  tracker.reset(0, 0);
   Habc.clear();
   Hab.clear();
   Hca.clear();
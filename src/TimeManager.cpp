@@ -0,0 +1,40 @@
+#include "TimeManager.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "GameConfig.h"
+
+void TimeManager::set_budget(double round_budget_ms)
+{
+	if (round_budget_ms < 0)
+		throw std::invalid_argument("TimeManager: negative budget");
+	// the change applies to what is left of the round too
+	left_ms = std::max(0.0, left_ms + round_budget_ms - this->round_budget_ms);
+	this->round_budget_ms = round_budget_ms;
+}
+
+double TimeManager::allot_ms(int trick_id, int nbr_legal) const
+{
+	if (nbr_legal <= 1 || left_ms <= 0)
+		return 0;
+	// weight N_TRICKS - t over the sum of the weights still to come
+	const int t = std::min(std::max(trick_id, 0), Hokm::N_TRICKS - 1);
+	return left_ms * 2.0 / (Hokm::N_TRICKS + 1 - t);
+}
+
+TimeManager::Clock::time_point TimeManager::deadline(int trick_id, int nbr_legal, Clock::time_point hard) const
+{
+	const Clock::time_point now = Clock::now();
+	if (round_budget_ms <= 0 || hard <= now)
+		return hard;
+	const auto share = std::chrono::duration<double, std::milli>(allot_ms(trick_id, nbr_legal));
+	if (share >= hard - now)
+		return hard;
+	return now + std::chrono::duration_cast<Clock::duration>(share);
+}
+
+void TimeManager::spend(double ms)
+{
+	left_ms = std::max(0.0, left_ms - ms);
+}
@@ -0,0 +1,88 @@
+/*
+ * TimeManager_test.cpp
+ */
+#include "TimeManager.h"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#include "GameConfig.h"
+#include "ISMCTSAgent.h"
+#include "MonteCarloAgent.h"
+
+namespace {
+// The fastest of up to three first-trick moves of `agent` with a deadline
+// deadline_ms away, stopping at the first within slack_ms of it.
+double deadline_run(Agent &agent, int deadline_ms, double slack_ms)
+{
+	agent.set_seat(0);
+	Hand hand;
+	for (Cid id = 0; id < Card::N_CARDS; id += 4)
+		hand.add(Card(id));
+	State state;
+	state.reset();
+	state.trick_id = 0;
+	state.turn = 0;
+	state.ord = 0;
+	state.trump = 0;
+	History hist;
+	double ms = 0;
+	for (int run = 0; run < 3; run++)
+	{
+		agent.init_round(hand);
+		const auto t0 = std::chrono::steady_clock::now();
+		agent.act(state, hist, t0 + std::chrono::milliseconds(deadline_ms));
+		const double run_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+		if (run == 0 || run_ms < ms)
+			ms = run_ms;
+		if (ms <= deadline_ms + slack_ms)
+			break;
+	}
+	return ms;
+}
+}
+
+void TimeManager_test()
+{
+	// a round that spends each allotment: front-loaded, within budget, and
+	// nothing for forced moves
+	TimeManager timer(1300);
+	if (timer.allot_ms(3, 1) != 0)
+		throw std::runtime_error("TimeManager_test: time given to a forced move");
+	double first = 0, last = 0, total = 0;
+	bool decreasing = true;
+	for (int t = 0; t < Hokm::N_TRICKS; t++)
+	{
+		const double ms = timer.allot_ms(t, 2);
+		if (t == 0)
+			first = ms;
+		else
+			decreasing = decreasing && ms < last;
+		last = ms;
+		timer.spend(ms);
+		total += ms;
+	}
+	if (!decreasing || total > 1300 + 1e-6 || first <= last)
+		throw std::runtime_error("TimeManager_test: allotments not front-loaded or over budget");
+
+	// the table's deadline wins over a generous budget: the search stops
+	// within a clock check of it, plus the time to pick the card; the best of
+	// three runs counts, so one descheduled run does not fail it
+	const int deadline_ms = 20;
+	ISMCTSAgent agent(1000, 0, 1, 1 << 16, Rng(20));
+	const double ms = deadline_run(agent, deadline_ms, 1);
+	const bool met = ms <= deadline_ms + 1;
+	// the same in the double-dummy phase, from the first trick on, where a
+	// single full-deal solve takes far longer than the deadline
+	MonteCarloAgent dd_agent(1000, 0, 1, Hokm::N_TRICKS, Rng(20));
+	const double dd_ms = deadline_run(dd_agent, deadline_ms, 5);
+	const bool dd_met = dd_ms <= deadline_ms + 5;
+
+	std::cout << "TimeManager: allotments " << first << " .. " << last << " ms of 1300, " << total << " spent; "
+			  << deadline_ms << " ms deadline " << (met ? "met" : "missed") << ", stopped after " << ms << " ms ("
+			  << agent.last_iterations() << " iterations); double-dummy " << (dd_met ? "met" : "missed") << " after "
+			  << dd_ms << " ms (" << dd_agent.last_samples() << " samples)" << std::endl;
+	if (!met || !dd_met)
+		throw std::runtime_error("TimeManager_test: deadline overrun");
+}
@@ -0,0 +1,8 @@
+#include "Trick.h"
+
+void Hokm::trick_winners(const Cid (*tables)[N_PLAYERS], const Suit *led, const Suit *trump,
+						 int *winners, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; i++)
+		winners[i] = trick_winner(tables[i], led[i], trump[i]);
+}
@@ -0,0 +1,45 @@
+/*
+ * Trick_test.cpp
+ */
+#include "Trick.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+void Trick_test()
+{
+	std::mt19937 rnd(1);
+	const int n = 10000;
+	static Cid tables[n][Hokm::N_PLAYERS];
+	static Suit led[n], trump[n];
+	static int winners[n];
+	for (int i = 0; i < n; i++)
+	{
+		Cid deck[Card::N_CARDS];
+		for (Cid id = 0; id < Card::N_CARDS; id++)
+			deck[id] = id;
+		std::shuffle(deck, deck + Card::N_CARDS, rnd);
+		std::copy(deck, deck + Hokm::N_PLAYERS, tables[i]);
+		led[i] = Card(tables[i][rnd() % Hokm::N_PLAYERS]).suit();
+		trump[i] = rnd() % Card::N_SUITS;
+	}
+	Hokm::trick_winners(tables, led, trump, winners, n);
+
+	int mismatches = 0;
+	for (int i = 0; i < n; i++)
+	{
+		int best = 0;
+		for (int pl = 1; pl < Hokm::N_PLAYERS; pl++)
+			if (Card::cmp(Card(tables[i][pl]), Card(tables[i][best]), led[i], trump[i]) > 0)
+				best = pl;
+		mismatches += (best != winners[i]);
+	}
+	Card t[] = {Card("2S"), Card("AS"), Card("3H"), Card("KS")};
+	std::cout << "trick 2S AS 3H KS, led S, trump H: winner " << Hokm::trick_winner(t, Card::Spade, Card::Heart)
+			  << "; led S, trump D: winner " << Hokm::trick_winner(t, Card::Spade, Card::Diamond) << std::endl;
+	std::cout << "trick_winners vs Card::cmp on " << n << " tricks, mismatches: " << mismatches << std::endl;
+	if (mismatches)
+		throw std::runtime_error("Trick_test: trick_winners disagrees with Card::cmp");
+}
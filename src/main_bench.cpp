@@ -0,0 +1,144 @@
+// Scaling of the tree-parallel ISMCTS search: playouts per second on the
+// opening lead of a few fixed deals, from one thread up to max_threads
+// (default: one per hardware thread), doubling in between. Then the same for
+// double-dummy trick tables (all trumps and leaders) of full deals, and last
+// the mean time of a SoundAgent move over rounds of four SoundAgents.
+//
+//   hokm_bench [budget_ms [max_threads [nbr_deals [nbr_tables]]]]
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DoubleDummyBatch.h"
+#include "GameConfig.h"
+#include "GameRound.h"
+#include "ISMCTSAgent.h"
+
+namespace {
+// Wall time from each awaiting_card() to the card_played() after it.
+struct MoveTimer : NullObserver
+{
+	std::chrono::steady_clock::time_point asked;
+	double secs = 0;
+	long nbr_moves = 0;
+
+	void awaiting_card(int) { asked = std::chrono::steady_clock::now(); }
+	void card_played(int, const Card &, const State &)
+	{
+		secs += std::chrono::duration<double>(std::chrono::steady_clock::now() - asked).count();
+		nbr_moves++;
+	}
+};
+}
+
+int main(int argc, char *argv[])
+{
+	int budget_ms = 500;
+	unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+	int nbr_deals = 4;
+	int nbr_tables = 4;
+	if (argc > 1)
+		budget_ms = std::stoi(argv[1]);
+	if (argc > 2)
+		max_threads = std::stoul(argv[2]);
+	if (argc > 3)
+		nbr_deals = std::stoi(argv[3]);
+	if (argc > 4)
+		nbr_tables = std::stoi(argv[4]);
+
+	std::vector<unsigned> thread_counts;
+	for (unsigned n = 1; n < max_threads; n *= 2)
+		thread_counts.push_back(n);
+	thread_counts.push_back(max_threads);
+
+	std::cout << "ISMCTS scaling, " << budget_ms << " ms per decision, " << nbr_deals << " deals, "
+			  << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+	double base = 0;
+	for (unsigned n : thread_counts)
+	{
+		ISMCTSAgent agent(budget_ms, 0, n, 1 << 21, Rng(19));
+		agent.set_seat(0);
+		Rng deal_rng(19);
+		long playouts = 0;
+		double secs = 0;
+		for (int d = 0; d < nbr_deals; d++)
+		{
+			Cid ids[Card::N_CARDS];
+			for (Cid id = 0; id < Card::N_CARDS; id++)
+				ids[id] = id;
+			for (int i = Card::N_CARDS - 1; i > 0; i--)
+				std::swap(ids[i], ids[deal_rng.below(i + 1)]);
+			Hand hand;
+			for (int i = 0; i < Hokm::N_DELT; i++)
+				hand.add(Card(ids[i]));
+			agent.init_round(hand);
+
+			State state;
+			state.reset();
+			state.trick_id = 0;
+			state.turn = 0;
+			state.ord = 0;
+			state.trump = Card(ids[0]).suit();
+			History hist;
+			auto t0 = std::chrono::steady_clock::now();
+			agent.act(state, hist, t0 + std::chrono::milliseconds(budget_ms));
+			secs += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+			playouts += agent.last_iterations();
+		}
+		const double rate = playouts / secs;
+		if (base == 0)
+			base = rate;
+		std::cout << std::setw(4) << n << " threads: " << std::fixed << std::setprecision(0) << std::setw(10) << rate
+				  << " playouts/s, speedup " << std::setprecision(2) << rate / base << std::endl;
+	}
+
+	std::cout << "Double-dummy trick tables, " << nbr_tables << " full deals" << std::endl;
+	std::vector<std::array<std::uint64_t, Hokm::N_PLAYERS>> deals(nbr_tables);
+	Rng deal_rng(13);
+	for (auto &deal : deals)
+	{
+		Cid ids[Card::N_CARDS];
+		for (Cid id = 0; id < Card::N_CARDS; id++)
+			ids[id] = id;
+		for (int i = Card::N_CARDS - 1; i > 0; i--)
+			std::swap(ids[i], ids[deal_rng.below(i + 1)]);
+		deal.fill(0);
+		for (int i = 0; i < Card::N_CARDS; i++)
+			deal[i % Hokm::N_PLAYERS] |= 1ull << ids[i];
+	}
+	base = 0;
+	for (unsigned n : thread_counts)
+	{
+		DoubleDummyBatch batch(n);
+		auto t0 = std::chrono::steady_clock::now();
+		batch.solve_tables(deals);
+		const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+		const double rate = nbr_tables / secs;
+		if (base == 0)
+			base = rate;
+		std::cout << std::setw(4) << n << " threads: " << std::fixed << std::setprecision(3) << std::setw(10) << rate
+				  << " tables/s, " << std::setprecision(0) << 1000 * secs / nbr_tables << " ms per table, speedup "
+				  << std::setprecision(2) << rate / base << std::endl;
+	}
+
+	const int nbr_rounds = 1000;
+	SoundAgent s0, s1, s2, s3;
+	GameRound round({&s0, &s1, &s2, &s3}, Rng(24));
+	MoveTimer timer;
+	for (int r = 0; r < nbr_rounds; r++)
+	{
+		round.reset();
+		round.deal_n_init();
+		round.trump_call();
+		round.play(timer);
+	}
+	std::cout << "SoundAgent moves, " << nbr_rounds << " rounds: " << std::setprecision(2)
+			  << 1e6 * timer.secs / timer.nbr_moves << " us per move" << std::endl;
+	return 0;
+}
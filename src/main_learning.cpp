@@ -21,8 +21,16 @@ int main(int argc, char* argv[])
 	if (argc > 4){
 		max_prob = std::stod(argv[4]);
 	}
+	Rng rng = Rng::from_entropy();
+	if (argc > 5){
+		rng = Rng(std::stoull(argv[5]));
+	}
+	int nbr_threads = 0;
+	if (argc > 6){
+		nbr_threads = std::stoi(argv[6]);
+	}
 
-	LearningGame game{nbr_probs, min_prob, max_prob};
+	LearningGame game{nbr_probs, min_prob, max_prob, rng, nbr_threads};
 
 	game.play(nbr_episodes);
 
@@ -3,14 +3,25 @@
 // Function declarations for each test
 void Card_test();
 void CardStack_test();
+void CardTracker_test();
+void DealSampler_test();
 void Deck_test();
+void DoubleDummy_test();
+void DoubleDummyBatch_test();
+void GameRound_test();
 void Hand_test();
 void History_test();
+void ISMCTSAgent_test();
+void Rng_test();
+void RoundState_test();
 // void InteractiveAgent_test();
 // void InteractiveGame_test();
-// void LearningGame_test();
+void LearningGame_test();
+void MonteCarloAgent_test();
 // void SoundAgent_test();
 void State_test();
+void TimeManager_test();
+void Trick_test();
 void utils_test();
 
 int main() {
@@ -21,20 +32,43 @@ int main() {
 	CardStack_test();
 	Hand_test();
 	Deck_test();
+	CardTracker_test();
+	DealSampler_test();
 	State_test();
 	History_test();
+	Trick_test();
+	Rng_test();
+	RoundState_test();
+	DoubleDummy_test();
+	DoubleDummyBatch_test();
+	GameRound_test();
+	LearningGame_test();
+	MonteCarloAgent_test();
+	TimeManager_test();
+	ISMCTSAgent_test();
 #endif
     std::cout << "Running all tests..." << std::endl;
     Card_test();
     CardStack_test();
+    CardTracker_test();
+    DealSampler_test();
     Deck_test();
+    DoubleDummy_test();
+    DoubleDummyBatch_test();
+    GameRound_test();
     Hand_test();
     History_test();
+    ISMCTSAgent_test();
+    Rng_test();
+    RoundState_test();
     // InteractiveAgent_test();
     // InteractiveGame_test();
-    // LearningGame_test();
+    LearningGame_test();
+    MonteCarloAgent_test();
     // SoundAgent_test();
     State_test();
+    TimeManager_test();
+    Trick_test();
     utils_test();
     std::cout << "All tests passed!" << std::endl;
     return 0;